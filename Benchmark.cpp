@@ -0,0 +1,386 @@
+#include "sources/MagicalContainer.hpp"
+#include "sources/PrimeSieve.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace ariel;
+
+/*
+ * A small Google Benchmark style harness: every benchmark runs over a fixture (a container of a given size,
+ * filled from a given distribution), is repeated until it has run for at least the minimum time,
+ * and is reported as JSON in Google Benchmark's output format.
+ *
+ * Usage: ./benchmark [--max-size=N] [--min-time=SECONDS] [--filter=SUBSTRING] [--output=FILE]
+ */
+
+namespace {
+    // Sinks results, so the optimizer cannot drop the measured work.
+    volatile int64_t sink = 0;
+
+    // The amount of probe elements per addElement/removeElement iteration.
+    constexpr size_t PROBES = 64;
+
+    struct Options {
+        size_t max_size = 10000000;
+        double min_time = 0.1;
+        string filter;
+        string output;
+    };
+
+    /*
+     * A container and the values it was filled with, for one distribution and size.
+     */
+    struct Fixture {
+        string distribution;
+        vector<int> values;
+        MagicalContainer container;
+
+        // Elements that are not in the container, spread over its range.
+        vector<int> absent;
+
+        // Elements that are in the container, spread over its range.
+        vector<int> present;
+    };
+
+    /*
+     * The state of a running benchmark: the timer, and the amount of items processed.
+     */
+    class State {
+        private:
+            chrono::steady_clock::duration _elapsed {};
+            chrono::steady_clock::time_point _start;
+            size_t _items = 0;
+
+        public:
+            void resume() {
+                _start = chrono::steady_clock::now();
+            }
+
+            void pause() {
+                _elapsed += chrono::steady_clock::now() - _start;
+            }
+
+            void addItems(size_t items) {
+                _items += items;
+            }
+
+            double seconds() const {
+                return chrono::duration<double>(_elapsed).count();
+            }
+
+            size_t items() const {
+                return _items;
+            }
+    };
+
+    struct Benchmark {
+        string name;
+
+        // Runs one iteration over a fixture. It must leave the fixture as it found it.
+        function<void(Fixture &, State &)> iteration;
+    };
+
+    struct Result {
+        string name;
+        size_t iterations;
+        double nanoseconds_per_iteration;
+        double nanoseconds_per_item;
+        double items_per_second;
+    };
+
+    // All the primes below a bound, with a plain sieve of Eratosthenes.
+    vector<int> primesBelow(size_t bound) {
+        vector<bool> composite(bound, false);
+        vector<int> primes;
+
+        for (size_t number = 2; number < bound; ++number) {
+            if (composite[number])
+                continue;
+
+            primes.push_back(static_cast<int>(number));
+
+            for (size_t multiple = number * number; multiple < bound; multiple += number)
+                composite[multiple] = true;
+        }
+
+        return primes;
+    }
+
+    // n values, in the order they are inserted. Sequential values are the ascending odd numbers, leaving gaps for probes.
+    vector<int> generate(const string &distribution, size_t count) {
+        vector<int> values(count);
+
+        if (distribution == "sequential") {
+            for (size_t index = 0; index < count; ++index)
+                values[index] = static_cast<int>(2 * index + 1);
+        }
+
+        else if (distribution == "random") {
+            mt19937 generator(42);
+            uniform_int_distribution<int> uniform(0, INT32_MAX - 1);
+
+            for (int &value : values)
+                value = uniform(generator);
+        }
+
+        else {
+            // The first n primes: the n-th prime is below n (ln n + ln ln n) for n >= 6.
+            double n = static_cast<double>(max<size_t>(count, 6));
+            vector<int> primes = primesBelow(static_cast<size_t>(n * (log(n) + log(log(n)))) + 16);
+            primes.resize(count);
+
+            // Inserted in random order, like the random distribution.
+            shuffle(primes.begin(), primes.end(), mt19937(42));
+            values = move(primes);
+        }
+
+        return values;
+    }
+
+    Fixture makeFixture(const string &distribution, size_t count) {
+        Fixture fixture;
+        fixture.distribution = distribution;
+        fixture.values = generate(distribution, count);
+        fixture.container.addElements(fixture.values.begin(), fixture.values.end());
+        fixture.container.materializeViews();
+
+        size_t size = fixture.container.size();
+        size_t probes = min(PROBES, size);
+
+        for (size_t probe = 0; probe < probes; ++probe) {
+            int element = fixture.container.nthAscending(probe * size / probes);
+            fixture.present.push_back(element);
+
+            int candidate = element + 1;
+            while (fixture.container.contains(candidate) || find(fixture.absent.begin(), fixture.absent.end(), candidate) != fixture.absent.end())
+                ++candidate;
+
+            fixture.absent.push_back(candidate);
+        }
+
+        return fixture;
+    }
+
+    vector<Benchmark> benchmarks() {
+        return {
+            {"addElement", [](Fixture &fixture, State &state) {
+                state.resume();
+                for (int element : fixture.absent)
+                    fixture.container.addElement(element);
+                state.pause();
+
+                state.addItems(fixture.absent.size());
+                fixture.container.removeElements(fixture.absent.begin(), fixture.absent.end());
+            }},
+            {"removeElement", [](Fixture &fixture, State &state) {
+                state.resume();
+                for (int element : fixture.present)
+                    fixture.container.removeElement(element);
+                state.pause();
+
+                state.addItems(fixture.present.size());
+                fixture.container.addElements(fixture.present.begin(), fixture.present.end());
+            }},
+            {"addElements", [](Fixture &fixture, State &state) {
+                state.resume();
+                MagicalContainer container;
+                container.addElements(fixture.values.begin(), fixture.values.end());
+                sink = static_cast<int64_t>(container.size());
+                state.pause();
+
+                state.addItems(fixture.values.size());
+            }},
+            {"contains", [](Fixture &fixture, State &state) {
+                int64_t found = 0;
+
+                state.resume();
+                for (int element : fixture.values)
+                    found += fixture.container.contains(element);
+                state.pause();
+
+                sink = found;
+                state.addItems(fixture.values.size());
+            }},
+            {"traverse/ascending", [](Fixture &fixture, State &state) {
+                int64_t sum = 0;
+
+                state.resume();
+                MagicalContainer::AscendingIterator iterator(fixture.container);
+                for (auto it = iterator.begin(); it != iterator.end(); ++it)
+                    sum += *it;
+                state.pause();
+
+                sink = sum;
+                state.addItems(fixture.container.size());
+            }},
+            {"traverse/sidecross", [](Fixture &fixture, State &state) {
+                int64_t sum = 0;
+
+                state.resume();
+                MagicalContainer::SideCrossIterator iterator(fixture.container);
+                for (auto it = iterator.begin(); it != iterator.end(); ++it)
+                    sum += *it;
+                state.pause();
+
+                sink = sum;
+                state.addItems(fixture.container.size());
+            }},
+            {"traverse/prime", [](Fixture &fixture, State &state) {
+                int64_t sum = 0;
+
+                state.resume();
+                MagicalContainer::PrimeIterator iterator(fixture.container);
+                for (auto it = iterator.begin(); it != iterator.end(); ++it)
+                    sum += *it;
+                state.pause();
+
+                sink = sum;
+                state.addItems(fixture.container.primeCount());
+            }},
+            {"compare/ascending", [](Fixture &fixture, State &state) {
+                int64_t less = 0;
+
+                state.resume();
+                MagicalContainer::AscendingIterator iterator(fixture.container);
+                auto middle = iterator.begin() + static_cast<ptrdiff_t>(fixture.container.size() / 2);
+                for (auto it = iterator.begin(); it != iterator.end(); ++it)
+                    less += (it < middle) + (it == middle);
+                state.pause();
+
+                sink = less;
+                state.addItems(2 * fixture.container.size());
+            }},
+            {"isPrime", [](Fixture &fixture, State &state) {
+                int64_t primes = 0;
+
+                state.resume();
+                for (int element : fixture.values)
+                    primes += PrimeSieve::isPrime(element);
+                state.pause();
+
+                sink = primes;
+                state.addItems(fixture.values.size());
+            }},
+        };
+    }
+
+    // Runs a benchmark over a fixture, doubling the iterations until it ran for at least the minimum time.
+    Result run(const string &name, const Benchmark &benchmark, Fixture &fixture, double min_time) {
+        size_t iterations = 1;
+
+        while (true) {
+            State state;
+
+            for (size_t iteration = 0; iteration < iterations; ++iteration)
+                benchmark.iteration(fixture, state);
+
+            if (state.seconds() >= min_time || iterations >= (size_t(1) << 30)) {
+                double items = static_cast<double>(max<size_t>(state.items(), 1));
+                double nanoseconds = state.seconds() * 1e9;
+                return {name, iterations, nanoseconds / static_cast<double>(iterations), nanoseconds / items, items / state.seconds()};
+            }
+
+            iterations *= 2;
+        }
+    }
+
+    void writeJson(ostream &out, const vector<Result> &results) {
+        out << "{\n  \"context\": {\n"
+            << "    \"executable\": \"benchmark\",\n"
+            << "    \"checked_iterators\": " << (CHECKED_ITERATORS ? "true" : "false") << "\n"
+            << "  },\n  \"benchmarks\": [\n";
+
+        for (size_t index = 0; index < results.size(); ++index) {
+            const Result &result = results[index];
+
+            // Like Google Benchmark, real_time is per iteration, and the per-item time is a user counter.
+            out << "    {\"name\": \"" << result.name << "\", \"run_type\": \"iteration\", \"iterations\": " << result.iterations
+                << ", \"real_time\": " << result.nanoseconds_per_iteration << ", \"time_unit\": \"ns\", \"items_per_second\": "
+                << result.items_per_second << ", \"ns_per_item\": " << result.nanoseconds_per_item << "}"
+                << (index + 1 < results.size() ? "," : "") << "\n";
+        }
+
+        out << "  ]\n}\n";
+    }
+
+    Options parse(int argc, char **argv) {
+        Options options;
+
+        for (int index = 1; index < argc; ++index) {
+            string argument = argv[index];
+            size_t equals = argument.find('=');
+            string key = argument.substr(0, equals), value = (equals == string::npos) ? "" : argument.substr(equals + 1);
+
+            if (key == "--max-size")
+                options.max_size = stoul(value);
+            else if (key == "--min-time")
+                options.min_time = stod(value);
+            else if (key == "--filter")
+                options.filter = value;
+            else if (key == "--output")
+                options.output = value;
+            else
+                throw invalid_argument("Unknown argument: " + argument);
+        }
+
+        return options;
+    }
+}
+
+int main(int argc, char **argv) {
+    Options options;
+
+    try {
+        options = parse(argc, argv);
+    }
+
+    catch (const exception &error) {
+        cerr << error.what() << "\nUsage: " << argv[0] << " [--max-size=N] [--min-time=SECONDS] [--filter=SUBSTRING] [--output=FILE]" << endl;
+        return 1;
+    }
+
+    vector<Result> results;
+
+    for (const string distribution : {"sequential", "random", "prime-dense"}) {
+        for (size_t size = 10; size <= options.max_size; size *= 10) {
+            unique_ptr<Fixture> fixture;
+
+            for (const Benchmark &benchmark : benchmarks()) {
+                string name = benchmark.name + "/" + distribution + "/" + to_string(size);
+
+                if (name.find(options.filter) == string::npos)
+                    continue;
+
+                // Fixtures are only built for sizes that have a benchmark to run.
+                if (!fixture)
+                    fixture = make_unique<Fixture>(makeFixture(distribution, size));
+
+                results.push_back(run(name, benchmark, *fixture, options.min_time));
+                cerr << name << ": " << results.back().nanoseconds_per_item << " ns/item" << endl;
+            }
+        }
+    }
+
+    if (options.output.empty()) {
+        writeJson(cout, results);
+    }
+
+    else {
+        ofstream out(options.output);
+        writeJson(out, results);
+    }
+
+    return 0;
+}
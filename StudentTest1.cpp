@@ -1,6 +1,24 @@
 #include "doctest.h"
 #include "sources/MagicalContainer.hpp"
+#include "sources/PrimeSieve.hpp"
+#include "sources/IIterator.hpp"
+#include "sources/ConcurrentMagicalContainer.hpp"
+#include "sources/SnapshotMagicalContainer.hpp"
+#include "sources/ShardedMagicalContainer.hpp"
+#include "sources/ParallelBuilder.hpp"
+#include "sources/Arena.hpp"
+#include "sources/MappedMagicalContainer.hpp"
+#include "sources/StreamLoader.hpp"
 #include <stdexcept>
+#include <algorithm>
+#include <iterator>
+#include <ranges>
+#include <thread>
+#include <atomic>
+#include <climits>
+#include <fstream>
+#include <cstdio>
+#include <sstream>
 
 using namespace ariel;
 using namespace std;
@@ -597,3 +615,1247 @@ TEST_CASE("operator= throws when iterators are pointing at different containers"
 }
 
 
+// Test case for keeping every order in sync while elements are added and removed
+TEST_CASE("Orders stay in sync after mixed insertions and removals") {
+    MagicalContainer container;
+    container.addElement(7);
+    container.addElement(4);
+    container.addElement(11);
+    container.addElement(1);
+    container.addElement(7);
+    container.addElement(2);
+    container.removeElement(4);
+    container.addElement(9);
+    container.removeElement(11);
+
+    CHECK(container.size() == 4);
+    CHECK_THROWS_AS(container.removeElement(11), runtime_error);
+
+    SUBCASE("Ascending order") {
+        MagicalContainer::AscendingIterator it(container);
+        CHECK(*it == 1);
+        CHECK(*(++it) == 2);
+        CHECK(*(++it) == 7);
+        CHECK(*(++it) == 9);
+        CHECK(++it == it.end());
+    }
+
+    SUBCASE("Prime order") {
+        MagicalContainer::PrimeIterator it(container);
+        CHECK(*it == 2);
+        CHECK(*(++it) == 7);
+        CHECK(++it == it.end());
+    }
+
+    SUBCASE("SideCross order") {
+        MagicalContainer::SideCrossIterator it(container);
+        CHECK(*it == 1);
+        CHECK(*(++it) == 9);
+        CHECK(*(++it) == 2);
+        CHECK(*(++it) == 7);
+        CHECK(++it == it.end());
+    }
+}
+
+// Test case for the SideCrossIterator following the container as it grows
+TEST_CASE("SideCrossIterator reflects elements added after its creation") {
+    MagicalContainer container;
+    container.addElement(1);
+    container.addElement(2);
+
+    MagicalContainer::SideCrossIterator it(container);
+    CHECK(*it == 1);
+    ++it;
+    CHECK(*it == 2);
+
+    container.addElement(3);
+    container.addElement(4);
+    CHECK(*it == 4);
+    ++it;
+    CHECK(*it == 2);
+    ++it;
+    CHECK(*it == 3);
+    ++it;
+    CHECK(it == it.end());
+}
+
+// Test case for the prime classification engine
+TEST_CASE("PrimeSieve classification") {
+    SUBCASE("Small values") {
+        CHECK_FALSE(PrimeSieve::isPrime(-7));
+        CHECK_FALSE(PrimeSieve::isPrime(0));
+        CHECK_FALSE(PrimeSieve::isPrime(1));
+        CHECK(PrimeSieve::isPrime(2));
+        CHECK(PrimeSieve::isPrime(3));
+        CHECK_FALSE(PrimeSieve::isPrime(9));
+        CHECK(PrimeSieve::isPrime(65521));
+        CHECK_FALSE(PrimeSieve::isPrime(65535));
+    }
+
+    SUBCASE("Values that grow the sieve") {
+        CHECK(PrimeSieve::isPrime(65537));
+        CHECK_FALSE(PrimeSieve::isPrime(1000001));
+        CHECK(PrimeSieve::isPrime(1000003));
+    }
+
+    SUBCASE("Values beyond the sieve") {
+        CHECK(PrimeSieve::isPrime(2147483647));
+        CHECK_FALSE(PrimeSieve::isPrime(2147483646));
+        CHECK_FALSE(PrimeSieve::isPrime(25326001));
+        CHECK(PrimeSieve::isPrime(1000000007));
+    }
+}
+
+// Test case for adding a batch of elements at once
+TEST_CASE("Adding elements in bulk") {
+    MagicalContainer container;
+    container.addElement(4);
+    container.addElement(7);
+
+    SUBCASE("Initializer list with duplicates and existing elements") {
+        container.addElements({9, 2, 7, 2, 13, 1, 4});
+        CHECK(container.size() == 6);
+
+        MagicalContainer::AscendingIterator asc(container);
+        CHECK(*asc == 1);
+        CHECK(*(++asc) == 2);
+        CHECK(*(++asc) == 4);
+        CHECK(*(++asc) == 7);
+        CHECK(*(++asc) == 9);
+        CHECK(*(++asc) == 13);
+
+        MagicalContainer::PrimeIterator prime(container);
+        CHECK(*prime == 2);
+        CHECK(*(++prime) == 7);
+        CHECK(*(++prime) == 13);
+        CHECK(++prime == prime.end());
+    }
+
+    SUBCASE("Iterator range") {
+        vector<int> values;
+        for (int i = 100; i > 0; --i)
+            values.push_back(i);
+
+        container.addElements(values.begin(), values.end());
+        CHECK(container.size() == 100);
+
+        size_t primes = 0;
+        MagicalContainer::PrimeIterator prime(container);
+        for (auto it = prime.begin(); it != prime.end(); ++it)
+            ++primes;
+
+        CHECK(primes == 25);
+    }
+
+    SUBCASE("Empty batch") {
+        container.addElements({});
+        CHECK(container.size() == 2);
+    }
+}
+
+// Test case for removing a batch of elements at once
+TEST_CASE("Removing elements in bulk") {
+    MagicalContainer container;
+    for (int i = 1; i <= 20; ++i)
+        container.addElement(i);
+
+    SUBCASE("List of values, ignoring missing ones") {
+        CHECK(container.removeElements({3, 4, 4, 17, 25, -1}) == 3);
+        CHECK(container.size() == 17);
+
+        MagicalContainer::PrimeIterator prime(container);
+        CHECK(*prime == 2);
+        CHECK(*(++prime) == 5);
+        CHECK(*(++prime) == 7);
+        CHECK(*(++prime) == 11);
+        CHECK(*(++prime) == 13);
+        CHECK(*(++prime) == 19);
+        CHECK(++prime == prime.end());
+    }
+
+    SUBCASE("Value range") {
+        CHECK(container.removeRange(5, 12) == 7);
+        CHECK(container.removeRange(30, 40) == 0);
+        CHECK(container.size() == 13);
+
+        MagicalContainer::AscendingIterator asc(container);
+        CHECK(*(++(++(++(++asc)))) == 12);
+
+        MagicalContainer::PrimeIterator prime(container);
+        CHECK(*prime == 2);
+        CHECK(*(++prime) == 3);
+        CHECK(*(++prime) == 13);
+    }
+
+    SUBCASE("Predicate") {
+        CHECK(container.removeIf([](int element) { return element % 2 == 0; }) == 10);
+        CHECK(container.size() == 10);
+
+        MagicalContainer::SideCrossIterator cross(container);
+        CHECK(*cross == 1);
+        CHECK(*(++cross) == 19);
+
+        MagicalContainer::PrimeIterator prime(container);
+        CHECK(*prime == 3);
+    }
+
+    SUBCASE("Throwing predicate leaves the container unchanged") {
+        int calls = 0;
+        container.materializeViews();
+
+        CHECK_THROWS_AS(container.removeIf([&calls](int element) {
+            if (++calls == 4)
+                throw runtime_error("Predicate failed");
+
+            return element == 2;
+        }), runtime_error);
+
+        CHECK(container.size() == 20);
+        CHECK(container.primeCount() == 8);
+
+        MagicalContainer::AscendingIterator asc(container);
+        for (int i = 1; i <= 20; ++i, ++asc)
+            CHECK(*asc == i);
+
+        MagicalContainer::PrimeIterator prime(container);
+        CHECK(*prime == 2);
+        CHECK(*(++prime) == 3);
+        CHECK(*(++prime) == 5);
+    }
+}
+
+// Test case for the opt-in polymorphic iterator interface
+TEST_CASE("IteratorAdapter compares through IIterator") {
+    MagicalContainer container;
+    container.addElements({1, 2, 3});
+
+    IteratorAdapter<MagicalContainer::AscendingIterator> asc1(MagicalContainer::AscendingIterator{container});
+    IteratorAdapter<MagicalContainer::AscendingIterator> asc2(MagicalContainer::AscendingIterator{container});
+    IteratorAdapter<MagicalContainer::PrimeIterator> prime(MagicalContainer::PrimeIterator{container});
+
+    const IIterator &first = asc1;
+    const IIterator &second = asc2;
+
+    CHECK(first == second);
+    ++asc1;
+    CHECK(first != second);
+    CHECK(first > second);
+    CHECK(second < first);
+    CHECK(*asc1 == 2);
+    CHECK(*prime == 2);
+    CHECK_THROWS_AS((void)(first == prime), runtime_error);
+}
+
+// Test case for the unchecked iterator family
+TEST_CASE("Unchecked iterators walk the same orders") {
+    MagicalContainer container;
+    container.addElements({1, 2, 4, 5, 14});
+
+    SUBCASE("Ascending") {
+        vector<int> values;
+        MagicalContainer::UncheckedAscendingIterator it(container);
+        for (auto current = it.begin(); current != it.end(); ++current)
+            values.push_back(*current);
+        CHECK(values == vector<int>{1, 2, 4, 5, 14});
+    }
+
+    SUBCASE("SideCross") {
+        vector<int> values;
+        MagicalContainer::UncheckedSideCrossIterator it(container);
+        for (auto current = it.begin(); current != it.end(); ++current)
+            values.push_back(*current);
+        CHECK(values == vector<int>{1, 14, 2, 5, 4});
+    }
+
+    SUBCASE("Prime") {
+        vector<int> values;
+        MagicalContainer::UncheckedPrimeIterator it(container);
+        for (auto current = it.begin(); current != it.end(); ++current)
+            values.push_back(*current);
+        CHECK(values == vector<int>{2, 5});
+    }
+
+    SUBCASE("Unchecked operations do not throw") {
+        MagicalContainer::UncheckedAscendingIterator it(container);
+        CHECK(noexcept(*it));
+        CHECK(noexcept(++it));
+        CHECK(noexcept(it != it.end()));
+        CHECK_FALSE(noexcept(*MagicalContainer::BasicAscendingIterator<true>(container)));
+    }
+}
+
+// Test case for using the iterators as standard random-access iterators and ranges
+TEST_CASE("Iterators model random-access iterators and sized ranges") {
+    static_assert(std::random_access_iterator<MagicalContainer::AscendingIterator>);
+    static_assert(std::random_access_iterator<MagicalContainer::SideCrossIterator>);
+    static_assert(std::random_access_iterator<MagicalContainer::PrimeIterator>);
+    static_assert(std::random_access_iterator<MagicalContainer::UncheckedAscendingIterator>);
+    static_assert(std::ranges::sized_range<MagicalContainer::AscendingIterator>);
+    static_assert(std::ranges::sized_range<MagicalContainer::SideCrossIterator>);
+    static_assert(std::ranges::sized_range<MagicalContainer::PrimeIterator>);
+
+    MagicalContainer container;
+    container.addElements({1, 2, 4, 5, 14, 17, 20});
+
+    SUBCASE("Arithmetic and subscript") {
+        MagicalContainer::AscendingIterator it(container);
+        CHECK(it[3] == 5);
+        CHECK(*(it + 6) == 20);
+        CHECK(*(2 + it) == 4);
+        CHECK((it.end() - it) == 7);
+        CHECK(it.size() == 7);
+
+        it += 4;
+        CHECK(*it == 14);
+        CHECK(*(it--) == 14);
+        CHECK(*it == 5);
+        CHECK(*(--it) == 4);
+        CHECK(*(it++) == 4);
+        CHECK(*it == 5);
+        CHECK(it <= it);
+        CHECK(it >= it.begin());
+
+        CHECK_THROWS_AS(it -= 5, runtime_error);
+        CHECK_THROWS_AS(it += 5, runtime_error);
+        CHECK_THROWS_AS((void)it[-4], runtime_error);
+        CHECK_THROWS_AS(--(it.begin()), runtime_error);
+    }
+
+    SUBCASE("Standard algorithms") {
+        MagicalContainer::AscendingIterator asc(container);
+        CHECK(*std::lower_bound(asc.begin(), asc.end(), 6) == 14);
+        CHECK(std::ranges::binary_search(asc, 17));
+
+        MagicalContainer::PrimeIterator prime(container);
+        CHECK(std::ranges::distance(prime) == 3);
+        CHECK(*std::ranges::upper_bound(prime, 5) == 17);
+
+        MagicalContainer::SideCrossIterator cross(container);
+        CHECK(*std::ranges::max_element(cross) == 20);
+        CHECK(std::count_if(cross.begin(), cross.end(), [](int element) { return element % 2 == 0; }) == 4);
+    }
+}
+
+// Test case for looking up elements in every order
+TEST_CASE("Membership and lookup") {
+    MagicalContainer container;
+    container.addElements({1, 2, 4, 5, 14});
+
+    CHECK(container.contains(4));
+    CHECK_FALSE(container.contains(3));
+
+    SUBCASE("Ascending") {
+        auto it = container.findAscending(5);
+        CHECK(*it == 5);
+        CHECK((it - it.begin()) == 3);
+        CHECK(container.findAscending(3) == it.end());
+    }
+
+    SUBCASE("SideCross") {
+        for (int element : {1, 2, 4, 5, 14})
+            CHECK(*container.findSideCross(element) == element);
+
+        auto it = container.findSideCross(5);
+        CHECK((it - it.begin()) == 3);
+        CHECK(*(++it) == 4);
+        CHECK(container.findSideCross(100) == it.end());
+    }
+
+    SUBCASE("Prime") {
+        auto it = container.findPrime(5);
+        CHECK(*it == 5);
+        CHECK((it - it.begin()) == 1);
+        CHECK(container.findPrime(4) == it.end());
+        CHECK(container.findPrime(7) == it.end());
+    }
+
+    SUBCASE("Explicitly checked or unchecked results") {
+        static_assert(is_same_v<decltype(container.findAscending(5)), MagicalContainer::AscendingIterator>);
+        static_assert(is_same_v<decltype(container.findPrime<false>(5)), MagicalContainer::UncheckedPrimeIterator>);
+        static_assert(is_same_v<decltype(container.ascendingRange<true>(1, 5).first), MagicalContainer::BasicAscendingIterator<true>>);
+
+        auto it = container.findAscending<true>(14);
+        CHECK(*it == 14);
+        CHECK_THROWS_AS(++(++it), runtime_error);
+        CHECK(*container.upperBoundPrime<false>(2) == 5);
+    }
+}
+
+// Test case for value range queries
+TEST_CASE("Range queries") {
+    MagicalContainer container;
+    for (int i = 1; i <= 30; ++i)
+        container.addElement(i);
+
+    SUBCASE("Bounds") {
+        CHECK(*container.lowerBoundAscending(10) == 10);
+        CHECK(*container.upperBoundAscending(10) == 11);
+        CHECK(container.lowerBoundAscending(31) == MagicalContainer::AscendingIterator(container).end());
+        CHECK(*container.lowerBoundPrime(8) == 11);
+        CHECK(*container.upperBoundPrime(11) == 13);
+        CHECK(container.upperBoundPrime(29) == MagicalContainer::PrimeIterator(container).end());
+    }
+
+    SUBCASE("Ascending range") {
+        auto range = container.ascendingRange(10, 15);
+        vector<int> values(range.first, range.second);
+        CHECK(values == vector<int>{10, 11, 12, 13, 14});
+        CHECK(container.countInRange(10, 15) == 5);
+        CHECK(container.countInRange(15, 10) == 0);
+        CHECK(container.countInRange(-100, 100) == 30);
+    }
+
+    SUBCASE("Prime range") {
+        auto range = container.primeRange(10, 20);
+        vector<int> values(range.first, range.second);
+        CHECK(values == vector<int>{11, 13, 17, 19});
+        CHECK(container.countPrimesInRange(10, 20) == 4);
+        CHECK(container.countPrimesInRange(1, 31) == 10);
+        CHECK(container.countPrimesInRange(20, 10) == 0);
+    }
+}
+
+// Test case for positional access and ranks
+TEST_CASE("Order statistics") {
+    MagicalContainer container;
+    container.addElements({1, 2, 4, 5, 14, 17});
+
+    SUBCASE("k-th element") {
+        CHECK(container.nthAscending(0) == 1);
+        CHECK(container.nthAscending(4) == 14);
+        CHECK(container.nthSideCross(1) == 17);
+        CHECK(container.nthSideCross(5) == 5);
+        CHECK(container.nthPrime(2) == 17);
+        CHECK(container.primeCount() == 3);
+
+        CHECK_THROWS_AS((void)container.nthAscending(6), runtime_error);
+        CHECK_THROWS_AS((void)container.nthSideCross(6), runtime_error);
+        CHECK_THROWS_AS((void)container.nthPrime(3), runtime_error);
+    }
+
+    SUBCASE("Ranks") {
+        CHECK(container.rankOf(1) == 0);
+        CHECK(container.rankOf(5) == 3);
+        CHECK(container.rankOf(6) == 4);
+        CHECK(container.primeRankOf(17) == 2);
+        CHECK(container.primeRankOf(3) == 1);
+
+        for (size_t k = 0; k < container.size(); ++k)
+            CHECK(container.sideCrossRankOf(container.nthSideCross(k)) == k);
+
+        CHECK_THROWS_AS((void)container.sideCrossRankOf(3), runtime_error);
+    }
+}
+
+// Test case for the thread-safe container under concurrent readers and writers
+TEST_CASE("ConcurrentMagicalContainer with concurrent readers and writers") {
+    ConcurrentMagicalContainer container;
+    atomic<bool> sorted{true};
+    vector<thread> threads;
+
+    for (int writer = 0; writer < 4; ++writer) {
+        threads.emplace_back([&container, writer]() {
+            for (int i = 0; i < 250; ++i)
+                container.addElement(writer * 1000 + i);
+        });
+    }
+
+    for (int reader = 0; reader < 4; ++reader) {
+        threads.emplace_back([&container, &sorted]() {
+            for (int i = 0; i < 50; ++i) {
+                auto view = container.lockShared();
+                MagicalContainer::AscendingIterator it(view.container());
+                if (!std::is_sorted(it.begin(), it.end()))
+                    sorted = false;
+            }
+        });
+    }
+
+    for (auto &worker : threads)
+        worker.join();
+
+    CHECK(sorted);
+    CHECK(container.size() == 1000);
+    CHECK(container.contains(3249));
+    CHECK(container.read([](const MagicalContainer &locked) { return locked.countInRange(0, 250); }) == 250);
+
+    container.removeElement(0);
+    CHECK(container.removeElements({1, 2, 5000}) == 2);
+    CHECK(container.removeRange(1000, 2000) == 250);
+    container.write([](MagicalContainer &locked) { locked.addElements({-1, -2}); });
+    CHECK(container.size() == 749);
+    CHECK_THROWS_AS(container.removeElement(0), runtime_error);
+}
+
+// Test case for immutable snapshots under concurrent writers
+TEST_CASE("SnapshotMagicalContainer keeps snapshots stable") {
+    SnapshotMagicalContainer container;
+    container.addElements({1, 2, 3, 4, 5});
+
+    SUBCASE("A snapshot does not see later writes") {
+        auto snapshot = container.snapshot();
+        MagicalContainer::AscendingIterator it(*snapshot);
+        ++it;
+
+        container.addElement(0);
+        container.removeElement(2);
+        CHECK(container.removeRange(4, 10) == 2);
+
+        CHECK(*it == 2);
+        CHECK(snapshot->size() == 5);
+        CHECK(container.size() == 3);
+        CHECK_FALSE(container.contains(2));
+        CHECK_THROWS_AS(container.removeElement(2), runtime_error);
+        CHECK(container.size() == 3);
+    }
+
+    SUBCASE("Batched update") {
+        size_t removed = container.update([](MagicalContainer &next) {
+            next.addElements({10, 11});
+            return next.removeIf([](int element) { return element % 2 == 0; });
+        });
+
+        CHECK(removed == 3);
+        CHECK(container.snapshot()->primeCount() == 3);
+    }
+
+    SUBCASE("Readers see whole versions while a writer publishes") {
+        atomic<bool> consistent{true};
+        thread writer([&container]() {
+            for (int i = 6; i < 300; ++i)
+                container.addElements({i, -i});
+        });
+
+        thread reader([&container, &consistent]() {
+            for (int i = 0; i < 300; ++i) {
+                auto snapshot = container.snapshot();
+                MagicalContainer::SideCrossIterator it(*snapshot);
+                // Every version holds the pairs (i, -i) together, plus the 5 original elements.
+                if (std::ranges::distance(it) % 2 != 1 || !std::is_sorted(MagicalContainer::AscendingIterator(*snapshot).begin(), MagicalContainer::AscendingIterator(*snapshot).end()))
+                    consistent = false;
+            }
+        });
+
+        writer.join();
+        reader.join();
+        CHECK(consistent);
+        CHECK(container.size() == 593);
+    }
+}
+
+// Test case for the sharded container matching a single container
+TEST_CASE("ShardedMagicalContainer traverses shards as one container") {
+    ShardedMagicalContainer sharded(vector<int>{0, 100, 1000});
+    MagicalContainer reference;
+
+    CHECK(sharded.shardCount() == 4);
+    CHECK_THROWS_AS(ShardedMagicalContainer(vector<int>{5, 5}), runtime_error);
+
+    vector<thread> writers;
+    for (int writer = 0; writer < 4; ++writer) {
+        writers.emplace_back([&sharded, writer]() {
+            for (int i = 0; i < 200; ++i)
+                sharded.addElement((i * 37 + writer * 11) % 2000 - 500);
+        });
+    }
+
+    for (auto &writer : writers)
+        writer.join();
+
+    for (int writer = 0; writer < 4; ++writer)
+        for (int i = 0; i < 200; ++i)
+            reference.addElement((i * 37 + writer * 11) % 2000 - 500);
+
+    sharded.addElements({5000, -5000, 5000});
+    reference.addElements({5000, -5000});
+    CHECK(sharded.removeElements({7, 8, 9, 5000}) == reference.removeElements({7, 8, 9, 5000}));
+    CHECK(sharded.removeRange(90, 110) == reference.removeRange(90, 110));
+    CHECK_THROWS_AS(sharded.removeElement(95), runtime_error);
+
+    CHECK(sharded.size() == reference.size());
+    CHECK(sharded.contains(-5000));
+    CHECK_FALSE(sharded.contains(95));
+
+    vector<int> ascending, prime, cross;
+    sharded.forEachAscending([&ascending](int element) { ascending.push_back(element); });
+    sharded.forEachPrime([&prime](int element) { prime.push_back(element); });
+    sharded.forEachSideCross([&cross](int element) { cross.push_back(element); });
+
+    MagicalContainer::AscendingIterator asc(reference);
+    MagicalContainer::PrimeIterator primes(reference);
+    MagicalContainer::SideCrossIterator sides(reference);
+    CHECK(ascending == vector<int>(asc.begin(), asc.end()));
+    CHECK(prime == vector<int>(primes.begin(), primes.end()));
+    CHECK(cross == vector<int>(sides.begin(), sides.end()));
+
+    CHECK(sharded.nthAscending(10) == reference.nthAscending(10));
+    CHECK(sharded.nthSideCross(11) == reference.nthSideCross(11));
+    CHECK_THROWS_AS((void)sharded.nthAscending(reference.size()), runtime_error);
+
+    ShardedMagicalContainer even(3);
+    even.addElements({INT_MIN, -1, 0, 1, INT_MAX});
+    vector<int> spread;
+    even.forEachSideCross([&spread](int element) { spread.push_back(element); });
+    CHECK(spread == vector<int>{INT_MIN, INT_MAX, -1, 1, 0});
+}
+
+// Test case for the parallel bulk builder matching the serial one
+TEST_CASE("ParallelBuilder builds the same container as addElements") {
+    vector<int> values;
+    for (int i = 0; i < 200000; ++i)
+        values.push_back((i * 7919) % 150001 - 20000);
+
+    MagicalContainer serial;
+    serial.addElements(values.begin(), values.end());
+
+    ParallelBuilder builder(4);
+    CHECK(builder.threads() == 4);
+
+    SUBCASE("Build from scratch") {
+        MagicalContainer parallel = builder.build(values);
+        MagicalContainer::AscendingIterator asc(parallel), serial_asc(serial);
+        MagicalContainer::PrimeIterator prime(parallel), serial_prime(serial);
+
+        CHECK(parallel.size() == serial.size());
+        CHECK(std::equal(asc.begin(), asc.end(), serial_asc.begin(), serial_asc.end()));
+        CHECK(std::equal(prime.begin(), prime.end(), serial_prime.begin(), serial_prime.end()));
+    }
+
+    SUBCASE("Merge into an existing container") {
+        MagicalContainer parallel;
+        parallel.addElements({-50000, 3, 17, 200000});
+        builder.addElements(parallel, values);
+        serial.addElements({-50000, 3, 17, 200000});
+
+        MagicalContainer::AscendingIterator asc(parallel), serial_asc(serial);
+        MagicalContainer::PrimeIterator prime(parallel), serial_prime(serial);
+
+        CHECK(parallel.size() == serial.size());
+        CHECK(std::equal(asc.begin(), asc.end(), serial_asc.begin(), serial_asc.end()));
+        CHECK(std::equal(prime.begin(), prime.end(), serial_prime.begin(), serial_prime.end()));
+    }
+
+    SUBCASE("Small batches") {
+        MagicalContainer small = builder.build({5, 3, 5, 1});
+        CHECK(small.size() == 3);
+        CHECK(small.primeCount() == 2);
+        CHECK(builder.build({}).size() == 0);
+    }
+}
+
+// Test case for splitting traversals into chunks for parallel consumers
+TEST_CASE("Splitting iterator ranges") {
+    MagicalContainer container;
+    for (int i = 1; i <= 1000; ++i)
+        container.addElement(i);
+
+    SUBCASE("Chunks cover the order exactly once") {
+        MagicalContainer::SideCrossIterator cross(container);
+        auto chunks = cross.split(7);
+
+        CHECK(chunks.size() == 7);
+        CHECK(chunks.front().first == cross.begin());
+        CHECK(chunks.back().second == cross.end());
+
+        for (size_t part = 0; part + 1 < chunks.size(); ++part)
+            CHECK(chunks[part].second == chunks[part + 1].first);
+
+        for (const auto &chunk : chunks) {
+            auto size = chunk.second - chunk.first;
+            CHECK((size == 142 || size == 143));
+        }
+    }
+
+    SUBCASE("Chunks processed on several threads") {
+        MagicalContainer::PrimeIterator prime(container);
+        auto chunks = prime.split(4);
+        vector<long> sums(chunks.size(), 0);
+        vector<thread> workers;
+
+        for (size_t part = 0; part < chunks.size(); ++part) {
+            workers.emplace_back([&chunks, &sums, part]() {
+                for (auto it = chunks[part].first; it != chunks[part].second; ++it)
+                    sums[part] += *it;
+            });
+        }
+
+        for (auto &worker : workers)
+            worker.join();
+
+        long total = 0;
+        for (auto it = prime.begin(); it != prime.end(); ++it)
+            total += *it;
+
+        long chunked = 0;
+        for (long sum : sums)
+            chunked += sum;
+
+        CHECK(chunked == total);
+    }
+
+    SUBCASE("Splitting from the middle and more parts than elements") {
+        MagicalContainer::AscendingIterator asc(container);
+        asc += 998;
+        auto chunks = asc.split(4);
+
+        CHECK(chunks.size() == 4);
+        CHECK(*chunks[1].first == 999);
+        CHECK(*chunks[3].first == 1000);
+        CHECK(chunks[0].first == chunks[0].second);
+        CHECK(chunks[3].second == asc.end());
+    }
+}
+
+TEST_CASE("Templated containers over other key types") {
+    // Only the explicitly instantiated combinations are accepted, any other one would fail to link.
+    static_assert(IS_SUPPORTED_CONTAINER<int64_t, std::less<int64_t>, std::allocator<int64_t>>);
+    static_assert(IS_SUPPORTED_CONTAINER<int, std::greater<int>, std::allocator<int>>);
+    static_assert(!IS_SUPPORTED_CONTAINER<uint32_t, std::less<uint32_t>, std::allocator<uint32_t>>);
+    static_assert(!IS_SUPPORTED_CONTAINER<int64_t, std::greater<int64_t>, std::allocator<int64_t>>);
+
+    SUBCASE("64-bit keys and primes") {
+        BasicMagicalContainer<int64_t> container;
+        container.addElements({-5, 4294967311LL, 4294967297LL, 1000000007LL, 2});
+
+        CHECK(container.size() == 5);
+        CHECK(container.primeCount() == 3);
+        CHECK(container.nthAscending(0) == -5);
+        CHECK(container.nthPrime(0) == 2);
+        CHECK(container.nthPrime(2) == 4294967311LL);
+        CHECK(container.contains(4294967297LL));
+
+        vector<int64_t> primes;
+        for (BasicMagicalContainer<int64_t>::PrimeIterator it(container); it != it.end(); ++it)
+            primes.push_back(*it);
+
+        CHECK(primes == vector<int64_t>{2, 1000000007LL, 4294967311LL});
+    }
+
+    SUBCASE("Unsigned 64-bit keys") {
+        BasicMagicalContainer<uint64_t> container;
+        container.addElement(18446744073709551557ULL);
+        container.addElement(18446744073709551615ULL);
+        container.addElement(0);
+
+        CHECK(container.primeCount() == 1);
+        CHECK(container.nthPrime(0) == 18446744073709551557ULL);
+        CHECK(container.nthSideCross(1) == 18446744073709551615ULL);
+    }
+
+    SUBCASE("Narrow keys") {
+        BasicMagicalContainer<int16_t> container;
+        container.addElements({32749, -32768, 7, 8});
+        container.removeElement(8);
+
+        CHECK(container.size() == 3);
+        CHECK(container.primeCount() == 2);
+        CHECK(container.nthPrime(1) == 32749);
+        CHECK_THROWS(container.removeElement(8));
+    }
+
+    SUBCASE("Custom ordering") {
+        BasicMagicalContainer<int, greater<int>> container;
+        container.addElements({1, 2, 3, 4, 5});
+        container.addElement(6);
+
+        CHECK(container.nthAscending(0) == 6);
+        CHECK(container.nthPrime(0) == 5);
+        CHECK(container.nthSideCross(1) == 1);
+        CHECK(container.countInRange(5, 2) == 3);
+        CHECK(container.removeRange(4, 1) == 3);
+        CHECK(container.size() == 3);
+    }
+}
+
+TEST_CASE("Filtered views") {
+    MagicalContainer container;
+    container.addElements({1, 2, 3, 4, 9, 10, 16});
+
+    size_t even = container.addView("even", [](int element) { return element % 2 == 0; });
+    size_t square = container.addView("square", [](int element) {
+        int root = 0;
+        while (root * root < element)
+            ++root;
+        return root * root == element;
+    });
+
+    CHECK(container.viewId("square") == square);
+    CHECK_THROWS(container.viewId("odd"));
+    CHECK_THROWS(container.addView("even", [](int) { return true; }));
+    CHECK_THROWS(MagicalContainer::FilteredIterator(container, 2));
+
+    SUBCASE("Iterators over different views are not comparable") {
+        MagicalContainer::FilteredIterator evens(container, even), squares(container, square);
+
+        CHECK_THROWS_AS((void)(evens == squares), runtime_error);
+        CHECK_THROWS_AS((void)(evens < squares), runtime_error);
+        CHECK_THROWS_AS((void)(evens - squares), runtime_error);
+        CHECK(evens == MagicalContainer::FilteredIterator(container, "even"));
+        CHECK((squares.end() - squares) == 4);
+    }
+
+    SUBCASE("Views are built from the existing elements") {
+        CHECK(container.viewSize(even) == 4);
+        CHECK(container.viewSize(square) == 4);
+        CHECK(container.nthInView(square, 3) == 16);
+        CHECK_THROWS(container.nthInView(square, 4));
+    }
+
+    SUBCASE("Views follow single insertions and removals") {
+        container.addElement(25);
+        container.addElement(6);
+        container.removeElement(4);
+
+        vector<int> evens, squares;
+        for (MagicalContainer::FilteredIterator it(container, even); it != it.end(); ++it)
+            evens.push_back(*it);
+        for (MagicalContainer::FilteredIterator it(container, "square"); it != it.end(); ++it)
+            squares.push_back(*it);
+
+        CHECK(evens == vector<int>{2, 6, 10, 16});
+        CHECK(squares == vector<int>{1, 9, 16, 25});
+    }
+
+    SUBCASE("Views follow bulk operations") {
+        container.addElements({36, 5, 8});
+        CHECK(container.viewSize(even) == 6);
+        CHECK(container.nthInView(square, 4) == 36);
+
+        container.removeRange(3, 10);
+        CHECK(container.viewSize(even) == 4);
+        CHECK(container.viewSize(square) == 3);
+
+        container.removeIf([](int element) { return element > 10; });
+        MagicalContainer::FilteredIterator it(container, even);
+        CHECK(vector<int>(it.begin(), it.end()) == vector<int>{2, 10});
+        CHECK(container.primeCount() == 1);
+    }
+
+    SUBCASE("Views are filled by the parallel builder") {
+        MagicalContainer empty;
+        empty.addView("even", [](int element) { return element % 2 == 0; });
+
+        ParallelBuilder(4).addElements(empty, {8, 3, 6, 1, 4});
+        CHECK(empty.viewSize(0) == 3);
+        CHECK(empty.nthInView(0, 2) == 8);
+    }
+}
+
+TEST_CASE("Lazily built views") {
+    MagicalContainer container;
+    size_t calls = 0;
+    size_t odd = container.addView("odd", [&calls](int element) {
+        ++calls;
+        return element % 2 != 0;
+    });
+
+    container.addElements({1, 2, 3, 4, 5});
+    container.addElement(6);
+    container.removeElement(1);
+    CHECK(calls == 0);
+
+    SUBCASE("Built on first use, then maintained incrementally") {
+        CHECK(container.viewSize(odd) == 2);
+        CHECK(calls == 5);
+
+        container.addElement(7);
+        container.addElements({9, 8});
+        CHECK(calls == 8);
+        CHECK(container.nthInView(odd, 3) == 9);
+        CHECK(calls == 8);
+    }
+
+    SUBCASE("Prime order built on first use") {
+        container.removeRange(5, 7);
+        CHECK(container.primeCount() == 2);
+
+        container.addElement(11);
+        MagicalContainer::PrimeIterator prime(container);
+        CHECK(vector<int>(prime.begin(), prime.end()) == vector<int>{2, 3, 11});
+
+        MagicalContainer other;
+        other.addElements({4, 5});
+        CHECK(other.findPrime(5) != other.findPrime(4));
+        CHECK(other.upperBoundPrime(0) == MagicalContainer::PrimeIterator(other));
+    }
+
+    SUBCASE("Materialized up front") {
+        container.materializeViews();
+        CHECK(calls == 5);
+        CHECK(container.viewSize(odd) == 2);
+        CHECK(calls == 5);
+    }
+
+    SUBCASE("Concurrent containers build views before releasing the write lock") {
+        ConcurrentMagicalContainer concurrent;
+        concurrent.addElements({1, 2, 3});
+        concurrent.write([](MagicalContainer &inner) { inner.addView("even", [](int element) { return element % 2 == 0; }); });
+
+        CHECK(concurrent.read([](const MagicalContainer &inner) { return inner.viewSize(0) + inner.primeCount(); }) == 3);
+
+        CHECK_THROWS_AS(concurrent.write([](MagicalContainer &inner) {
+            inner.addView("odd", [](int element) { return element % 2 != 0; });
+            throw runtime_error("Write failed");
+        }), runtime_error);
+
+        CHECK(concurrent.read([](const MagicalContainer &inner) { return inner.viewSize(inner.viewId("odd")); }) == 2);
+    }
+
+    SUBCASE("Concurrent readers build every view once") {
+        MagicalContainer shared;
+        atomic<size_t> shared_calls {0};
+        size_t square = shared.addView("square", [&shared_calls](int element) {
+            ++shared_calls;
+            int root = 0;
+            while (root * root < element)
+                ++root;
+            return root * root == element;
+        });
+
+        for (int i = 1; i <= 10000; ++i)
+            shared.addElement(i);
+
+        const MagicalContainer &reader = shared;
+        vector<size_t> primes(8), squares(8);
+        vector<thread> workers;
+
+        for (size_t worker = 0; worker < primes.size(); ++worker) {
+            workers.emplace_back([&reader, &primes, &squares, square, worker]() {
+                MagicalContainer::PrimeIterator prime(reader);
+                primes[worker] = static_cast<size_t>(std::distance(prime.begin(), prime.end()));
+                squares[worker] = reader.viewSize(square);
+            });
+        }
+
+        for (auto &worker : workers)
+            worker.join();
+
+        CHECK(count(primes.begin(), primes.end(), 1229) == 8);
+        CHECK(count(squares.begin(), squares.end(), 100) == 8);
+        CHECK(shared_calls == 10000);
+    }
+}
+
+TEST_CASE("Compact 32-bit positions") {
+    CHECK(sizeof(MagicalContainer::index_type) == 4);
+    CHECK(MagicalContainer::MAX_SIZE == 4294967295ULL);
+
+    MagicalContainer container;
+    vector<int> values(70000);
+    for (size_t index = 0; index < values.size(); ++index)
+        values[index] = static_cast<int>(index);
+
+    container.addElements(values.begin(), values.end());
+    container.addElement(-1);
+    container.removeRange(0, 2);
+
+    CHECK(container.primeCount() == 6935);
+    CHECK(container.nthPrime(6934) == 69997);
+    CHECK(container.removeIf([](int element) { return element % 2 == 0; }) == 34999);
+    CHECK(container.nthPrime(0) == 3);
+}
+
+namespace {
+    class CountingResource: public pmr::memory_resource {
+        public:
+            size_t allocations = 0;
+
+        private:
+            void *do_allocate(size_t bytes, size_t alignment) override {
+                ++allocations;
+                return pmr::new_delete_resource()->allocate(bytes, alignment);
+            }
+
+            void do_deallocate(void *pointer, size_t bytes, size_t alignment) override {
+                pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+            }
+
+            bool do_is_equal(const pmr::memory_resource &other) const noexcept override {
+                return this == &other;
+            }
+    };
+}
+
+TEST_CASE("Allocator-aware containers on an arena") {
+    CountingResource upstream;
+    Arena arena(4096, &upstream);
+
+    SUBCASE("Storage and index vectors come from the arena") {
+        PmrMagicalContainer container(arena.resource());
+        CHECK(container.get_allocator().resource() == arena.resource());
+
+        // With the global default resource disabled, any stray polymorphic allocation throws.
+        pmr::memory_resource *previous = pmr::set_default_resource(pmr::null_memory_resource());
+
+        for (int element = 0; element < 1000; ++element)
+            container.addElement(element);
+
+        container.addElements({5000, 5003, 5009});
+        container.removeRange(100, 900);
+        container.addView("even", [](int element) { return element % 2 == 0; });
+
+        CHECK(container.size() == 203);
+        CHECK(container.primeCount() == 41);
+        CHECK(container.viewSize(0) == 101);
+
+        pmr::set_default_resource(previous);
+        CHECK(upstream.allocations > 0);
+    }
+
+    SUBCASE("Many short-lived containers reuse the arena's blocks") {
+        for (int round = 0; round < 100; ++round) {
+            PmrMagicalContainer container(arena.resource());
+            container.addElements({1, 2, 3, 4, 5, 6, 7, 8, 9, 10});
+            CHECK(container.nthPrime(3) == 7);
+        }
+
+        size_t after_warmup = upstream.allocations;
+
+        for (int round = 0; round < 100; ++round) {
+            PmrMagicalContainer container(arena.resource());
+            container.addElements({1, 2, 3, 4, 5, 6, 7, 8, 9, 10});
+        }
+
+        CHECK(upstream.allocations == after_warmup);
+
+        arena.release();
+        PmrMagicalContainer container(arena.resource());
+        container.addElement(2);
+        CHECK(container.primeCount() == 1);
+    }
+
+    SUBCASE("Arena over a caller supplied buffer") {
+        alignas(max_align_t) static unsigned char buffer[1 << 16];
+        Arena local(buffer, sizeof(buffer), pmr::null_memory_resource());
+
+        PmrMagicalContainer container(local.resource());
+        container.addElements({11, 13, 17, 19, 23});
+        CHECK(container.primeCount() == 5);
+    }
+}
+
+TEST_CASE("Binary snapshot files") {
+    const string path = "magical_container_test.bin";
+
+    MagicalContainer container;
+    container.addElements({20, 3, 11, 4, 1, 7, 100, -8});
+    container.save(path);
+
+    SUBCASE("Round trip") {
+        MagicalContainer loaded;
+        loaded.addElements({999, 1000});
+        size_t big = loaded.addView("big", [](int element) { return element > 10; });
+        loaded.load(path);
+
+        CHECK(loaded.size() == container.size());
+        CHECK(loaded.primeCount() == 3);
+        CHECK(loaded.nthPrime(2) == 11);
+        CHECK(loaded.nthSideCross(1) == 100);
+        CHECK(loaded.viewSize(big) == 3);
+
+        loaded.addElement(13);
+        CHECK(loaded.nthPrime(3) == 13);
+    }
+
+    SUBCASE("Empty containers and other key types") {
+        MagicalContainer().save(path);
+        MagicalContainer empty;
+        empty.addElement(5);
+        empty.load(path);
+        CHECK(empty.size() == 0);
+        CHECK(empty.primeCount() == 0);
+
+        BasicMagicalContainer<int64_t> wide;
+        wide.addElements({4294967311LL, 6, 2});
+        wide.save(path);
+
+        BasicMagicalContainer<int64_t> wide_loaded;
+        wide_loaded.load(path);
+        CHECK(wide_loaded.nthPrime(1) == 4294967311LL);
+    }
+
+    SUBCASE("Invalid files leave the container unchanged") {
+        BasicMagicalContainer<int64_t> wide;
+        CHECK_THROWS_WITH(wide.load(path), "Snapshot file holds a different element type");
+
+        MagicalContainer target;
+        target.addElement(42);
+        CHECK_THROWS(target.load("no_such_directory/file.bin"));
+
+        {
+            ofstream corrupt(path, ios::binary | ios::trunc);
+            corrupt << "not a snapshot at all, but long enough to hold a header of sixty four bytes.";
+        }
+
+        CHECK_THROWS_WITH(target.load(path), "Not a container snapshot file");
+        CHECK(target.size() == 1);
+        CHECK(target.nthAscending(0) == 42);
+    }
+
+    SUBCASE("Files are read back with the ordering they were saved with") {
+        BasicMagicalContainer<int, greater<int>> descending;
+        descending.addElements({1, 2, 3, 5, 8, 13});
+        descending.save(path);
+
+        MagicalContainer ascending;
+        CHECK_THROWS_WITH(ascending.load(path), "Snapshot file was saved with a different ordering");
+
+        BasicMagicalContainer<int, greater<int>> loaded;
+        loaded.load(path);
+        CHECK(loaded.nthAscending(0) == 13);
+        CHECK(loaded.contains(8));
+    }
+
+    remove(path.c_str());
+}
+
+TEST_CASE("Memory-mapped read-only containers") {
+    const string path = "magical_container_mapped_test.bin";
+
+    MagicalContainer container;
+    for (int element = -10; element <= 200; element += 3)
+        container.addElement(element);
+
+    container.save(path);
+
+    SUBCASE("All three orders match the saved container") {
+        MappedMagicalContainer mapped(path);
+
+        CHECK(mapped.size() == container.size());
+        CHECK(mapped.primeCount() == container.primeCount());
+        CHECK(mapped.contains(47));
+        CHECK_FALSE(mapped.contains(48));
+        CHECK(mapped.nthSideCross(1) == 200);
+        CHECK_THROWS(mapped.nthPrime(mapped.primeCount()));
+
+        MappedMagicalContainer::AscendingIterator asc(mapped);
+        MagicalContainer::AscendingIterator expected_asc(container);
+        CHECK(equal(asc.begin(), asc.end(), expected_asc.begin(), expected_asc.end()));
+
+        MappedMagicalContainer::SideCrossIterator cross(mapped);
+        MagicalContainer::SideCrossIterator expected_cross(container);
+        CHECK(equal(cross.begin(), cross.end(), expected_cross.begin(), expected_cross.end()));
+
+        MappedMagicalContainer::UncheckedPrimeIterator prime(mapped);
+        MagicalContainer::PrimeIterator expected_prime(container);
+        CHECK(equal(prime.begin(), prime.end(), expected_prime.begin(), expected_prime.end()));
+    }
+
+    SUBCASE("Moving transfers the mapping") {
+        MappedMagicalContainer mapped(path);
+        MappedMagicalContainer moved(move(mapped));
+
+        CHECK(mapped.size() == 0);
+        CHECK(moved.nthAscending(0) == -10);
+
+        mapped = move(moved);
+        CHECK(mapped.nthPrime(0) == 2);
+    }
+
+    SUBCASE("Saving over a mapped file replaces it atomically") {
+        MappedMagicalContainer mapped(path);
+
+        MagicalContainer replacement;
+        replacement.addElements({4, 6, 7});
+        replacement.save(path);
+
+        CHECK(mapped.size() == container.size());
+        CHECK(mapped.nthAscending(0) == -10);
+        CHECK(mapped.contains(47));
+        CHECK_FALSE(ifstream(path + ".tmp").good());
+
+        MappedMagicalContainer remapped(path);
+        CHECK(remapped.size() == 3);
+        CHECK(remapped.nthPrime(0) == 7);
+    }
+
+    SUBCASE("Files saved with the greater ordering are mapped with it") {
+        BasicMagicalContainer<int, greater<int>> descending;
+        descending.addElements({1, 2, 3, 5, 8, 13});
+        descending.save(path);
+
+        BasicMappedMagicalContainer<int, greater<int>> mapped(path);
+
+        CHECK(mapped.nthAscending(0) == 13);
+        CHECK(mapped.nthSideCross(1) == 1);
+        CHECK(mapped.nthPrime(0) == 13);
+        CHECK(mapped.contains(8));
+        CHECK_FALSE(mapped.contains(4));
+
+        BasicMappedMagicalContainer<int, greater<int>>::SideCrossIterator cross(mapped);
+        BasicMagicalContainer<int, greater<int>>::SideCrossIterator expected_cross(descending);
+        CHECK(equal(cross.begin(), cross.end(), expected_cross.begin(), expected_cross.end()));
+    }
+
+    SUBCASE("Invalid files are rejected") {
+        CHECK_THROWS(MappedMagicalContainer{"no_such_directory/file.bin"});
+        CHECK_THROWS_WITH(BasicMappedMagicalContainer<uint64_t>{path}, "Snapshot file holds a different element type");
+
+        BasicMagicalContainer<int, greater<int>> descending;
+        descending.addElements({1, 2, 3, 5, 8, 13});
+        descending.save(path);
+        CHECK_THROWS_WITH(MappedMagicalContainer{path}, "Snapshot file was saved with a different ordering");
+
+        {
+            ofstream truncated(path, ios::binary | ios::trunc);
+            truncated << "MAGICCNT";
+        }
+
+        CHECK_THROWS_WITH(MappedMagicalContainer{path}, "Not a container snapshot file");
+    }
+
+    remove(path.c_str());
+}
+
+TEST_CASE("Streaming ingestion") {
+    SUBCASE("Newline-delimited text, across chunks and blocks") {
+        string text;
+        for (int value = 100000; value > 0; value -= 7)
+            text += to_string(value) + (value % 2 == 0 ? "\r\n" : "\n");
+        text += "  -5\t3 3";
+
+        istringstream input(text);
+        MagicalContainer container;
+        StreamLoader loader(1000);
+
+        CHECK(loader.loadText(container, input) == 14286 + 3);
+        CHECK(container.size() == 14286 + 2);
+        CHECK(container.nthAscending(0) == -5);
+        CHECK(container.contains(99993));
+        CHECK(container.contains(3));
+    }
+
+    SUBCASE("Malformed text") {
+        MagicalContainer container;
+        istringstream letters("1 2 x3");
+        CHECK_THROWS_WITH(StreamLoader().loadText(container, letters), "Invalid integer in input");
+
+        istringstream overflow("1 99999999999");
+        CHECK_THROWS_WITH(StreamLoader().loadText(container, overflow), "Integer out of range in input");
+
+        istringstream empty("   \n");
+        CHECK(StreamLoader().loadText(container, empty) == 0);
+    }
+
+    SUBCASE("Binary input and other targets") {
+        vector<int64_t> values = {5, 4294967311LL, -1, 5, 7};
+        string bytes(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(int64_t));
+
+        istringstream input(bytes);
+        BasicMagicalContainer<int64_t> container;
+        CHECK(BasicStreamLoader<int64_t>(2).loadBinary(container, input) == 5);
+        CHECK(container.size() == 4);
+        CHECK(container.nthPrime(2) == 4294967311LL);
+
+        istringstream truncated(bytes.substr(0, 12));
+        CHECK_THROWS_WITH(BasicStreamLoader<int64_t>().loadBinary(container, truncated), "Truncated binary input");
+
+        ConcurrentMagicalContainer concurrent;
+        istringstream text("7 8 9");
+        StreamLoader().loadText(concurrent, text);
+        CHECK(concurrent.size() == 3);
+
+        CHECK_THROWS(StreamLoader(0));
+        CHECK_THROWS(StreamLoader().loadTextFile(concurrent, "no_such_directory/file.txt"));
+    }
+}
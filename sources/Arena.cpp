@@ -0,0 +1,32 @@
+/*
+ *  Software Systems CPP Course Assignment 5
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "Arena.hpp"
+
+using namespace std;
+using namespace ariel;
+
+Arena::Arena(size_t initial_size, pmr::memory_resource *upstream):
+	_monotonic(initial_size == 0 ? 1024 : initial_size, upstream), _pool(&_monotonic) { }
+
+Arena::Arena(void *buffer, size_t size, pmr::memory_resource *upstream):
+	_monotonic(buffer, size, upstream), _pool(&_monotonic) { }
+
+void Arena::release() {
+	_pool.release();
+	_monotonic.release();
+}
@@ -0,0 +1,93 @@
+/*
+ *  Software Systems CPP Course Assignment 5
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace ariel
+{
+	/*
+	 * @brief A request-scoped memory arena for allocator-aware containers (see PmrMagicalContainer).
+	 * @note Allocations are served by a size-class pool (std::pmr::unsynchronized_pool_resource), so the blocks
+	 			a container frees while it grows are reused. The pool takes its chunks from a monotonic buffer
+				(std::pmr::monotonic_buffer_resource), optionally backed by a caller supplied buffer, which never
+				returns memory upstream until the arena is released or destroyed.
+	 * @note Building and tearing down many short-lived containers on an arena costs a handful of upstream
+	 			allocations in total, and everything is freed in one shot.
+	 * @note The arena is not thread-safe, use one arena per thread (or per request).
+	 * @note Containers allocated from the arena must be destroyed before it.
+	*/
+	class Arena
+	{
+		private:
+			/*
+			 * @brief The bump allocator that feeds the pool.
+			*/
+			std::pmr::monotonic_buffer_resource _monotonic;
+
+			/*
+			 * @brief The size-class pool that serves the allocations.
+			 * @note Declared after _monotonic, as it allocates from it.
+			*/
+			std::pmr::unsynchronized_pool_resource _pool;
+
+		public:
+			/*
+			 * @brief Construct a new Arena object.
+			 * @param initial_size The size of the first block requested from upstream, zero for the default size.
+			 * @param upstream The resource the arena takes its blocks from.
+			*/
+			explicit Arena(size_t initial_size = 0, std::pmr::memory_resource *upstream = std::pmr::get_default_resource());
+
+			/*
+			 * @brief Construct a new Arena object, that serves allocations from a given buffer first.
+			 * @param buffer The buffer to allocate from, it must outlive the arena.
+			 * @param size The size of the buffer in bytes.
+			 * @param upstream The resource the arena takes its blocks from, once the buffer is exhausted.
+			*/
+			Arena(void *buffer, size_t size, std::pmr::memory_resource *upstream = std::pmr::get_default_resource());
+
+			/*
+			 * @brief Destroy the Arena object, releasing all of its memory.
+			*/
+			~Arena() = default;
+
+			/*
+			 * @brief The arena is neither copyable nor movable, as containers refer to it by address.
+			*/
+			Arena(const Arena &other) = delete;
+			Arena(Arena &&other) = delete;
+			Arena &operator=(const Arena &other) = delete;
+			Arena &operator=(Arena &&other) = delete;
+
+			/*
+			 * @brief Get the memory resource to construct containers with.
+			 * @return The arena's memory resource.
+			*/
+			std::pmr::memory_resource *resource() {
+				return &_pool;
+			}
+
+			/*
+			 * @brief Release all the memory allocated from the arena at once.
+			 * @note Every container allocated from the arena must already be destroyed.
+			*/
+			void release();
+	};
+}
@@ -0,0 +1,46 @@
+/*
+ *  Software Systems CPP Course Assignment 5
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ConcurrentMagicalContainer.hpp"
+
+using namespace std;
+using namespace ariel;
+
+void ConcurrentMagicalContainer::addElement(int element) {
+	unique_lock<shared_mutex> lock(_mutex);
+	_container.addElement(element);
+}
+
+void ConcurrentMagicalContainer::removeElement(int element) {
+	unique_lock<shared_mutex> lock(_mutex);
+	_container.removeElement(element);
+}
+
+size_t ConcurrentMagicalContainer::removeRange(int low, int high) {
+	unique_lock<shared_mutex> lock(_mutex);
+	return _container.removeRange(low, high);
+}
+
+bool ConcurrentMagicalContainer::contains(int element) const {
+	shared_lock<shared_mutex> lock(_mutex);
+	return _container.contains(element);
+}
+
+size_t ConcurrentMagicalContainer::size() const {
+	shared_lock<shared_mutex> lock(_mutex);
+	return _container.size();
+}
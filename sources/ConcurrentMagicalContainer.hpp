@@ -0,0 +1,248 @@
+/*
+ *  Software Systems CPP Course Assignment 5
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "MagicalContainer.hpp"
+#include <mutex>
+#include <shared_mutex>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+namespace ariel
+{
+	/*
+	 * @brief A thread-safe wrapper around a MagicalContainer, with many-readers/one-writer semantics.
+	 * @note Readers share a std::shared_mutex, so they never block each other. Writers take it exclusively,
+	 			so they are serialized and only stall readers for the duration of a single mutation.
+	 * @note Iterators must only be used while a read lock is held, either inside read() or through a ReadView.
+	 * @note The wrapped container's views are kept built (see MagicalContainer::materializeViews), so readers
+	 			never build one under the shared lock.
+	*/
+	class ConcurrentMagicalContainer
+	{
+		private:
+			/*
+			 * @brief The wrapped container.
+			*/
+			MagicalContainer _container;
+
+			/*
+			 * @brief The lock that guards the wrapped container.
+			*/
+			mutable std::shared_mutex _mutex;
+
+		public:
+			/*
+			 * @brief A shared (read) lock on the container, that keeps it unchanged while it lives.
+			 * @note Create as many views as needed from different threads, they do not block each other.
+			*/
+			class ReadView
+			{
+				private:
+					/*
+					 * @brief The held read lock.
+					*/
+					std::shared_lock<std::shared_mutex> _lock;
+
+					/*
+					 * @brief The locked container.
+					*/
+					const MagicalContainer *_container;
+
+				public:
+					/*
+					 * @brief Construct a new Read View object, blocking until the read lock is acquired.
+					 * @param owner The concurrent container to lock.
+					*/
+					explicit ReadView(const ConcurrentMagicalContainer &owner): _lock(owner._mutex), _container(&owner._container) { }
+
+					/*
+					 * @brief Get the locked container.
+					 * @return A reference to the locked container, valid while this view lives.
+					*/
+					const MagicalContainer &container() const {
+						return *_container;
+					}
+			};
+
+			/*
+			 * @brief Construct a new Concurrent Magical Container object.
+			 * @note The container is empty by default.
+			*/
+			ConcurrentMagicalContainer() {
+				_container.materializeViews();
+			}
+
+			/*
+			 * @brief Destroy the Concurrent Magical Container object.
+			 * @note No thread may use the container while it is destroyed.
+			*/
+			~ConcurrentMagicalContainer() = default;
+
+			/*
+			 * @brief The container is neither copyable nor movable, as it owns its lock.
+			*/
+			ConcurrentMagicalContainer(const ConcurrentMagicalContainer &other) = delete;
+			ConcurrentMagicalContainer(ConcurrentMagicalContainer &&other) = delete;
+			ConcurrentMagicalContainer &operator=(const ConcurrentMagicalContainer &other) = delete;
+			ConcurrentMagicalContainer &operator=(ConcurrentMagicalContainer &&other) = delete;
+
+			/*
+			 * @brief Add an element to the container, under the write lock.
+			 * @param element The element to add.
+			*/
+			void addElement(int element);
+
+			/*
+			 * @brief Add a range of elements to the container, under a single write lock.
+			 * @param first An iterator to the first element to add.
+			 * @param last An iterator past the last element to add.
+			 * @note The range is copied before the lock is taken, to keep the write lock short.
+			*/
+			template <typename InputIt>
+			void addElements(InputIt first, InputIt last) {
+				std::vector<int> batch(first, last);
+				std::unique_lock<std::shared_mutex> lock(_mutex);
+				_container.addElements(batch.begin(), batch.end());
+			}
+
+			/*
+			 * @brief Add a list of elements to the container, under a single write lock.
+			 * @param elements The elements to add.
+			*/
+			void addElements(std::initializer_list<int> elements) {
+				addElements(elements.begin(), elements.end());
+			}
+
+			/*
+			 * @brief Remove an element from the container, under the write lock.
+			 * @param element The element to remove.
+			 * @throw std::runtime_error If the element does not exist in the container.
+			*/
+			void removeElement(int element);
+
+			/*
+			 * @brief Remove a range of elements from the container, under a single write lock.
+			 * @param first An iterator to the first element to remove.
+			 * @param last An iterator past the last element to remove.
+			 * @return The amount of elements removed.
+			*/
+			template <typename InputIt>
+			size_t removeElements(InputIt first, InputIt last) {
+				std::vector<int> batch(first, last);
+				std::unique_lock<std::shared_mutex> lock(_mutex);
+				return _container.removeElements(batch.begin(), batch.end());
+			}
+
+			/*
+			 * @brief Remove a list of elements from the container, under a single write lock.
+			 * @param elements The elements to remove.
+			 * @return The amount of elements removed.
+			*/
+			size_t removeElements(std::initializer_list<int> elements) {
+				return removeElements(elements.begin(), elements.end());
+			}
+
+			/*
+			 * @brief Remove all the elements in the value range [low, high), under the write lock.
+			 * @param low The smallest value to remove.
+			 * @param high The value after the biggest value to remove.
+			 * @return The amount of elements removed.
+			*/
+			size_t removeRange(int low, int high);
+
+			/*
+			 * @brief Check if an element exists in the container, under a read lock.
+			 * @param element The element to look for.
+			 * @return True if the element exists in the container, false otherwise.
+			*/
+			bool contains(int element) const;
+
+			/*
+			 * @brief Return the size of the container, under a read lock.
+			 * @return The size of the container.
+			*/
+			size_t size() const;
+
+			/*
+			 * @brief Run a function on the container under a read lock.
+			 * @param function A callable that takes a const MagicalContainer reference.
+			 * @return Whatever the function returns.
+			 * @note Iterators created inside the function must not escape it.
+			*/
+			template <typename Function>
+			decltype(auto) read(Function &&function) const {
+				std::shared_lock<std::shared_mutex> lock(_mutex);
+				return std::forward<Function>(function)(static_cast<const MagicalContainer &>(_container));
+			}
+
+			/*
+			 * @brief Run a function on the container under the write lock.
+			 * @param function A callable that takes a MagicalContainer reference.
+			 * @return Whatever the function returns.
+			 * @note Use this to group several mutations into a single critical section.
+			 * @note Views the function registers (or drops, by replacing the container) are built before the lock is released,
+			 			even if the function throws.
+			*/
+			template <typename Function>
+			decltype(auto) write(Function &&function) {
+				std::unique_lock<std::shared_mutex> lock(_mutex);
+
+				if constexpr (std::is_void_v<decltype(function(_container))>)
+				{
+					try
+					{
+						std::forward<Function>(function)(_container);
+					}
+
+					catch (...)
+					{
+						_container.materializeViews();
+						throw;
+					}
+
+					_container.materializeViews();
+				}
+
+				else
+				{
+					try
+					{
+						decltype(auto) result = std::forward<Function>(function)(_container);
+						_container.materializeViews();
+						return result;
+					}
+
+					catch (...)
+					{
+						_container.materializeViews();
+						throw;
+					}
+				}
+			}
+
+			/*
+			 * @brief Take a read lock on the container.
+			 * @return A view that holds the read lock until it is destroyed.
+			*/
+			ReadView lockShared() const {
+				return ReadView(*this);
+			}
+	};
+}
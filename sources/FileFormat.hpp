@@ -0,0 +1,164 @@
+/*
+ *  Software Systems CPP Course Assignment 5
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+
+namespace ariel
+{
+	/*
+	 * @brief The header of a container's binary snapshot file.
+	 * @note The file layout is the header, then the sorted elements, then the prime order (32-bit positions into
+	 			the elements). Both sections start at an offset aligned to ALIGNMENT bytes, so a mapped file can be read in place.
+	 * @note Values are stored in the writer's native byte order, and a byte order marker lets a reader on
+	 			a different architecture reject the file instead of misreading it.
+	 * @note The ordering the elements are sorted by is recorded too, as binary searching them with another ordering
+	 			silently gives wrong answers. Only std::less and std::greater can be recorded.
+	*/
+	struct FileHeader
+	{
+		/*
+		 * @brief The magic bytes that open every snapshot file.
+		*/
+		static constexpr std::array<char, 8> MAGIC = {'M', 'A', 'G', 'I', 'C', 'C', 'N', 'T'};
+
+		/*
+		 * @brief The current version of the format.
+		*/
+		static constexpr uint32_t VERSION = 2;
+
+		/*
+		 * @brief The byte order marker, as written by the native byte order.
+		*/
+		static constexpr uint32_t ENDIAN_MARKER = 0x01020304;
+
+		/*
+		 * @brief The ordering tags: the elements are sorted by std::less or by std::greater.
+		*/
+		static constexpr uint8_t ORDERING_LESS = 0;
+		static constexpr uint8_t ORDERING_GREATER = 1;
+
+		/*
+		 * @brief The alignment of the elements and prime order sections, in bytes.
+		*/
+		static constexpr uint64_t ALIGNMENT = 8;
+
+		std::array<char, 8> magic;
+		uint32_t version;
+		uint32_t byte_order;
+		uint8_t element_size;
+		uint8_t element_signed;
+		uint8_t index_size;
+		uint8_t ordering;
+		std::array<uint8_t, 12> reserved;
+		uint64_t count;
+		uint64_t prime_count;
+		uint64_t elements_offset;
+		uint64_t primes_offset;
+
+		/*
+		 * @brief Align an offset up to the next multiple of ALIGNMENT.
+		 * @param offset The offset to align.
+		 * @return The aligned offset.
+		*/
+		static constexpr uint64_t align(uint64_t offset) {
+			return (offset + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+		}
+
+		/*
+		 * @brief Get the ordering tag of an ordering.
+		 * @tparam T The element type.
+		 * @tparam Compare The ordering, std::less<T> or std::greater<T>.
+		 * @return The ordering's tag.
+		*/
+		template <typename T, typename Compare>
+		static constexpr uint8_t orderingOf() {
+			static_assert(std::is_same_v<Compare, std::less<T>> || std::is_same_v<Compare, std::greater<T>>,
+				"Snapshot files only record the std::less and std::greater orderings");
+
+			return std::is_same_v<Compare, std::greater<T>> ? ORDERING_GREATER : ORDERING_LESS;
+		}
+
+		/*
+		 * @brief Create the header of a file holding a given container.
+		 * @tparam T The element type.
+		 * @tparam Compare The ordering the elements are sorted by.
+		 * @tparam Index The position type of the prime order.
+		 * @param count The amount of elements.
+		 * @param prime_count The amount of prime elements.
+		 * @return The header, with the section offsets laid out.
+		*/
+		template <typename T, typename Compare, typename Index>
+		static FileHeader make(uint64_t count, uint64_t prime_count) {
+			FileHeader header {};
+
+			header.magic = MAGIC;
+			header.version = VERSION;
+			header.byte_order = ENDIAN_MARKER;
+			header.element_size = sizeof(T);
+			header.element_signed = std::is_signed_v<T> ? 1 : 0;
+			header.index_size = sizeof(Index);
+			header.ordering = orderingOf<T, Compare>();
+			header.count = count;
+			header.prime_count = prime_count;
+			header.elements_offset = align(sizeof(FileHeader));
+			header.primes_offset = align(header.elements_offset + count * sizeof(T));
+
+			return header;
+		}
+
+		/*
+		 * @brief Make sure the header describes a file that can be read as a given container.
+		 * @tparam T The element type.
+		 * @tparam Compare The ordering the reader binary searches the elements with.
+		 * @tparam Index The position type of the prime order.
+		 * @param file_size The size of the whole file in bytes, to check the sections against.
+		 * @throw std::runtime_error If the file is not a snapshot, was written by another version or architecture,
+		 			holds a different element type, was saved with a different ordering, or is truncated.
+		*/
+		template <typename T, typename Compare, typename Index>
+		void validate(uint64_t file_size) const {
+			if (magic != MAGIC)
+				throw std::runtime_error("Not a container snapshot file");
+
+			if (version != VERSION)
+				throw std::runtime_error("Unsupported snapshot file version");
+
+			if (byte_order != ENDIAN_MARKER)
+				throw std::runtime_error("Snapshot file has a different byte order");
+
+			if (element_size != sizeof(T) || element_signed != (std::is_signed_v<T> ? 1 : 0) || index_size != sizeof(Index))
+				throw std::runtime_error("Snapshot file holds a different element type");
+
+			if (ordering != orderingOf<T, Compare>())
+				throw std::runtime_error("Snapshot file was saved with a different ordering");
+
+			if (count > file_size || prime_count > count || elements_offset != align(sizeof(FileHeader)) || primes_offset != align(elements_offset + count * sizeof(T))
+				|| file_size < primes_offset + prime_count * sizeof(Index))
+				throw std::runtime_error("Snapshot file is truncated or corrupted");
+		}
+	};
+
+	static_assert((FileHeader::ALIGNMENT & (FileHeader::ALIGNMENT - 1)) == 0, "FileHeader::ALIGNMENT must be a power of two");
+	static_assert(sizeof(FileHeader) == 64 && std::is_trivially_copyable_v<FileHeader>, "FileHeader must have a fixed layout");
+}
@@ -17,10 +17,15 @@
 
 #pragma once
 
+#include <stdexcept>
+#include <utility>
+
 namespace ariel
 {
 	/*
 	 * @brief An interface for iterators.
+	 * @note The container's iterators do not implement this interface directly, so their comparisons
+	 			need no virtual dispatch. Wrap them with IteratorAdapter when polymorphic access is needed.
 	*/
 	class IIterator
 	{
@@ -103,4 +108,115 @@ namespace ariel
 			*/
 			IIterator& operator=(IIterator&& other) = default;
 	};
+
+	/*
+	 * @brief Adapts a concrete iterator to the polymorphic IIterator interface.
+	 * @tparam Iterator The iterator type to wrap.
+	 * @note Comparing two adapters costs a dynamic_cast, prefer comparing the wrapped iterators directly.
+	*/
+	template <typename Iterator>
+	class IteratorAdapter: public IIterator
+	{
+		private:
+			/*
+			 * @brief The wrapped iterator.
+			*/
+			Iterator _iterator;
+
+			/*
+			 * @brief Get the iterator wrapped by another adapter.
+			 * @param other The adapter to unwrap.
+			 * @return A reference to the iterator wrapped by the other adapter.
+			 * @throw std::runtime_error If the other iterator is not an adapter of the same type.
+			*/
+			static const Iterator &_unwrap(const IIterator &other) {
+				const auto *other_ptr = dynamic_cast<const IteratorAdapter *>(&other);
+
+				if (other_ptr == nullptr)
+					throw std::runtime_error("Cannot compare iterators of different types");
+
+				return other_ptr->_iterator;
+			}
+
+		public:
+			/*
+			 * @brief Construct a new Iterator Adapter object, wrapping an uninitialized iterator.
+			*/
+			IteratorAdapter() = default;
+
+			/*
+			 * @brief Construct a new Iterator Adapter object.
+			 * @param iterator The iterator to wrap.
+			*/
+			explicit IteratorAdapter(Iterator iterator): _iterator(std::move(iterator)) { }
+
+			/*
+			 * @brief Compare the wrapped iterator to the one wrapped by another adapter.
+			 * @param other The iterator to compare to, must be an adapter of the same type.
+			 * @return true if both wrapped iterators are equal, false otherwise.
+			 * @throw std::runtime_error If the other iterator is not an adapter of the same type, or the
+						wrapped iterators are from different containers.
+			*/
+			bool operator==(const IIterator &other) const override {
+				return _iterator == _unwrap(other);
+			}
+
+			/*
+			 * @brief Compare the wrapped iterator to the one wrapped by another adapter.
+			 * @param other The iterator to compare to, must be an adapter of the same type.
+			 * @return true if the wrapped iterators are not equal, false otherwise.
+			 * @throw std::runtime_error If the other iterator is not an adapter of the same type, or the
+						wrapped iterators are from different containers.
+			*/
+			bool operator!=(const IIterator &other) const override {
+				return _iterator != _unwrap(other);
+			}
+
+			/*
+			 * @brief Compare the wrapped iterator to the one wrapped by another adapter.
+			 * @param other The iterator to compare to, must be an adapter of the same type.
+			 * @return true if this wrapped iterator is smaller than the other, false otherwise.
+			 * @throw std::runtime_error If the other iterator is not an adapter of the same type, or the
+						wrapped iterators are from different containers.
+			*/
+			bool operator<(const IIterator &other) const override {
+				return _iterator < _unwrap(other);
+			}
+
+			/*
+			 * @brief Compare the wrapped iterator to the one wrapped by another adapter.
+			 * @param other The iterator to compare to, must be an adapter of the same type.
+			 * @return true if this wrapped iterator is bigger than the other, false otherwise.
+			 * @throw std::runtime_error If the other iterator is not an adapter of the same type, or the
+						wrapped iterators are from different containers.
+			*/
+			bool operator>(const IIterator &other) const override {
+				return _iterator > _unwrap(other);
+			}
+
+			/*
+			 * @brief Dereference operator, returns the element the wrapped iterator points to.
+			 * @return The element the wrapped iterator points to.
+			*/
+			decltype(auto) operator*() const {
+				return *_iterator;
+			}
+
+			/*
+			 * @brief Prefix increment operator, increments the wrapped iterator.
+			 * @return A reference to this adapter.
+			*/
+			IteratorAdapter &operator++() {
+				++_iterator;
+				return *this;
+			}
+
+			/*
+			 * @brief Get the wrapped iterator.
+			 * @return A reference to the wrapped iterator.
+			*/
+			const Iterator &iterator() const {
+				return _iterator;
+			}
+	};
 }
\ No newline at end of file
@@ -0,0 +1,530 @@
+/*
+ *  Software Systems CPP Course Assignment 5
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace ariel
+{
+	/*
+	 * @brief Whether the container's default iterators are checked.
+	 * @note Release builds (NDEBUG) default to unchecked iterators, unless ARIEL_CHECKED_ITERATORS is defined.
+	*/
+#if defined(NDEBUG) && !defined(ARIEL_CHECKED_ITERATORS)
+	inline constexpr bool CHECKED_ITERATORS = false;
+#else
+	inline constexpr bool CHECKED_ITERATORS = true;
+#endif
+
+	/*
+	 * @brief Map a position in sidecross order to its index in ascending order.
+	 * @param position The position in sidecross order.
+	 * @param count The number of elements in the container.
+	 * @return The ascending order index of the element at the given sidecross position.
+	 * @note Even positions walk from the start, odd positions walk from the end.
+	 * @note Time complexity: O(1).
+	*/
+	inline size_t sideCrossToAscending(size_t position, size_t count) {
+		return (position % 2 == 0) ? position / 2 : count - 1 - position / 2;
+	}
+
+	/*
+	 * @brief Map an index in ascending order to its position in sidecross order.
+	 * @param index The index in ascending order.
+	 * @param count The number of elements in the container.
+	 * @return The sidecross position of the element at the given ascending index.
+	 * @note The inverse of sideCrossToAscending. Time complexity: O(1).
+	*/
+	inline size_t ascendingToSideCross(size_t index, size_t count) {
+		return (index < (count + 1) / 2) ? 2 * index : 2 * (count - 1 - index) + 1;
+	}
+
+	/*
+	 * @brief A base for iterators that walk a container by index.
+	 * @tparam Derived The iterator class that inherits from this base (CRTP).
+	 * @tparam Container The container type the iterator walks over.
+	 * @tparam Value The type of the elements the iterator yields.
+	 * @tparam Checked Whether the iterator validates its state. A checked iterator throws std::runtime_error
+	 			on misuse, an unchecked iterator skips every check and leaves misuse undefined.
+	 * @note The derived class must provide a private _limit() method returning the index of its end() iterator,
+	 			accessible to this base (declare it as a friend). Any extra state the derived class holds
+				is carried along when the base repositions a copy of it (see _at).
+	 * @note All the operations are resolved at compile time, there is no virtual dispatch.
+	 * @note The iterator models std::random_access_iterator, and as it also provides begin(), end() and size(),
+	 			it can be used directly as a std::ranges::sized_range over its order.
+	*/
+	template <typename Derived, typename Container, typename Value, bool Checked>
+	class BasicIndexIterator
+	{
+		public:
+			using iterator_concept = std::random_access_iterator_tag;
+			using iterator_category = std::random_access_iterator_tag;
+			using value_type = Value;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const Value *;
+			using reference = const Value &;
+
+		protected:
+			/*
+			 * @brief The container to iterate over.
+			 * @note This is a reference to the container, so it must not be destroyed while the iterator is in use.
+			*/
+			const Container *_container;
+
+			/*
+			 * @brief The current index of the iterator.
+			 * @note The index is valid if it is less than the size of the iterated order.
+			*/
+			size_t _index;
+
+			/*
+			 * @brief Construct a new Basic Index Iterator object.
+			 * @param container The container to iterate over.
+			 * @param index The index to start iterating from.
+			*/
+			BasicIndexIterator(const Container *container, size_t index): _container(container), _index(index) { }
+
+			/*
+			 * @brief Get the derived iterator.
+			 * @return A reference to the derived iterator.
+			*/
+			const Derived &_derived() const {
+				return static_cast<const Derived &>(*this);
+			}
+
+			/*
+			 * @brief Get the derived iterator.
+			 * @return A reference to the derived iterator.
+			*/
+			Derived &_derived() {
+				return static_cast<Derived &>(*this);
+			}
+
+			/*
+			 * @brief Get a copy of the derived iterator, positioned at a given index.
+			 * @param index The index of the copy.
+			 * @return The repositioned copy.
+			*/
+			Derived _at(size_t index) const {
+				Derived copy(_derived());
+				copy._index = index;
+				return copy;
+			}
+
+			/*
+			 * @brief Move the iterator by a given offset.
+			 * @param offset The amount of positions to move, may be negative.
+			 * @throw std::runtime_error If checked, and the iterator is not initialized or would leave the range [begin(), end()].
+			*/
+			void _advance(difference_type offset) noexcept(!Checked) {
+				if constexpr (Checked)
+				{
+					_checkInitialized();
+
+					difference_type target = static_cast<difference_type>(_index) + offset;
+
+					if (target < 0 || target > static_cast<difference_type>(_derived()._limit()))
+						throw std::runtime_error("Iterator out of range");
+				}
+
+				_index = static_cast<size_t>(static_cast<difference_type>(_index) + offset);
+			}
+
+			/*
+			 * @brief Make sure the iterator points to a container.
+			 * @throw std::runtime_error If the iterator is not initialized.
+			*/
+			void _checkInitialized() const noexcept(!Checked) {
+				if constexpr (Checked)
+				{
+					if (_container == nullptr)
+						throw std::runtime_error("Iterator not initialized");
+				}
+			}
+
+			/*
+			 * @brief Make sure the iterator points to an element.
+			 * @throw std::runtime_error If the iterator is not initialized or out of range.
+			*/
+			void _checkDereferenceable() const noexcept(!Checked) {
+				if constexpr (Checked)
+				{
+					_checkInitialized();
+
+					if (_index >= _derived()._limit())
+						throw std::runtime_error("Iterator out of range");
+				}
+			}
+
+			/*
+			 * @brief Check if another iterator over the same container walks the same order as this one.
+			 * @param other The other iterator.
+			 * @return True, as by default the order is determined by the iterator's type.
+			 * @note A derived class whose order depends on extra state hides this method (see _checkComparable).
+			*/
+			bool _sameOrder(const Derived &other) const noexcept {
+				(void)other;
+				return true;
+			}
+
+			/*
+			 * @brief Make sure two iterators can be compared.
+			 * @param lhs The first iterator.
+			 * @param rhs The second iterator.
+			 * @throw std::runtime_error If one of the iterators is not initialized, they are from different containers,
+			 			or they walk different orders of the same container.
+			*/
+			static void _checkComparable(const Derived &lhs, const Derived &rhs) noexcept(!Checked) {
+				if constexpr (Checked)
+				{
+					if (lhs._container == nullptr || rhs._container == nullptr)
+						throw std::runtime_error("One of the iterators is not initialized");
+
+					else if (lhs._container != rhs._container)
+						throw std::runtime_error("Cannot compare iterators from different containers");
+
+					else if (!lhs._sameOrder(rhs))
+						throw std::runtime_error("Cannot compare iterators over different orders");
+				}
+			}
+
+		public:
+			/*
+			 * @brief Construct a new Basic Index Iterator object, uninitialized (points to no container).
+			 * @note This iterator is not dereferenceable, and must be assigned to a valid iterator before use.
+			*/
+			BasicIndexIterator(): _container(nullptr), _index(0) { }
+
+			/*
+			 * @brief Destroy the Basic Index Iterator object.
+			 * @note Use the default destructor, as the iterator does not own any memory.
+			*/
+			~BasicIndexIterator() = default;
+
+			/*
+			 * @brief Copy constructor.
+			 * @param other The iterator to copy.
+			*/
+			BasicIndexIterator(const BasicIndexIterator &other) = default;
+
+			/*
+			 * @brief Move constructor.
+			 * @param other The iterator to move.
+			 * @note The other iterator is left uninitialized.
+			*/
+			BasicIndexIterator(BasicIndexIterator &&other) noexcept: _container(other._container), _index(other._index) {
+				other._container = nullptr;
+				other._index = 0;
+			}
+
+			/*
+			 * @brief Copy assignment operator.
+			 * @param other The iterator to copy.
+			 * @return A reference to this iterator.
+			 * @throw std::runtime_error If checked, and both iterators are initialized and from different containers.
+			*/
+			BasicIndexIterator &operator=(const BasicIndexIterator &other) noexcept(!Checked) {
+				if (this != &other)
+				{
+					if constexpr (Checked)
+					{
+						if (_container != other._container && _container != nullptr && other._container != nullptr)
+							throw std::runtime_error("Cannot assign iterators from different containers");
+					}
+
+					_container = other._container;
+					_index = other._index;
+				}
+
+				return *this;
+			}
+
+			/*
+			 * @brief Move assignment operator.
+			 * @param other The iterator to move.
+			 * @return A reference to this iterator.
+			 * @note The other iterator is left uninitialized.
+			*/
+			BasicIndexIterator &operator=(BasicIndexIterator &&other) noexcept {
+				if (this != &other)
+				{
+					_container = other._container;
+					_index = other._index;
+
+					other._container = nullptr;
+					other._index = 0;
+				}
+
+				return *this;
+			}
+
+			/*
+			 * @brief Equality operator, checks if two iterators are equal by comparing their index.
+			 * @param lhs The first iterator.
+			 * @param rhs The second iterator.
+			 * @return True if the iterators are equal, false otherwise.
+			 * @throw std::runtime_error If checked, and one of the iterators is not initialized or they are from different containers.
+			*/
+			friend bool operator==(const Derived &lhs, const Derived &rhs) noexcept(!Checked) {
+				_checkComparable(lhs, rhs);
+				return lhs._index == rhs._index;
+			}
+
+			/*
+			 * @brief Inequality operator, checks if two iterators are not equal by comparing their index.
+			 * @param lhs The first iterator.
+			 * @param rhs The second iterator.
+			 * @return True if the iterators are not equal, false otherwise.
+			 * @throw std::runtime_error If checked, and one of the iterators is not initialized or they are from different containers.
+			*/
+			friend bool operator!=(const Derived &lhs, const Derived &rhs) noexcept(!Checked) {
+				_checkComparable(lhs, rhs);
+				return lhs._index != rhs._index;
+			}
+
+			/*
+			 * @brief Less than operator, checks if the first iterator is less than the second by comparing their index.
+			 * @param lhs The first iterator.
+			 * @param rhs The second iterator.
+			 * @return True if the first iterator is less than the second, false otherwise.
+			 * @throw std::runtime_error If checked, and one of the iterators is not initialized or they are from different containers.
+			*/
+			friend bool operator<(const Derived &lhs, const Derived &rhs) noexcept(!Checked) {
+				_checkComparable(lhs, rhs);
+				return lhs._index < rhs._index;
+			}
+
+			/*
+			 * @brief Greater than operator, checks if the first iterator is greater than the second by comparing their index.
+			 * @param lhs The first iterator.
+			 * @param rhs The second iterator.
+			 * @return True if the first iterator is greater than the second, false otherwise.
+			 * @throw std::runtime_error If checked, and one of the iterators is not initialized or they are from different containers.
+			*/
+			friend bool operator>(const Derived &lhs, const Derived &rhs) noexcept(!Checked) {
+				_checkComparable(lhs, rhs);
+				return lhs._index > rhs._index;
+			}
+
+			/*
+			 * @brief Less than or equal operator, checks if the first iterator is not greater than the second by comparing their index.
+			 * @param lhs The first iterator.
+			 * @param rhs The second iterator.
+			 * @return True if the first iterator is less than or equal to the second, false otherwise.
+			 * @throw std::runtime_error If checked, and one of the iterators is not initialized or they are from different containers.
+			*/
+			friend bool operator<=(const Derived &lhs, const Derived &rhs) noexcept(!Checked) {
+				_checkComparable(lhs, rhs);
+				return lhs._index <= rhs._index;
+			}
+
+			/*
+			 * @brief Greater than or equal operator, checks if the first iterator is not less than the second by comparing their index.
+			 * @param lhs The first iterator.
+			 * @param rhs The second iterator.
+			 * @return True if the first iterator is greater than or equal to the second, false otherwise.
+			 * @throw std::runtime_error If checked, and one of the iterators is not initialized or they are from different containers.
+			*/
+			friend bool operator>=(const Derived &lhs, const Derived &rhs) noexcept(!Checked) {
+				_checkComparable(lhs, rhs);
+				return lhs._index >= rhs._index;
+			}
+
+			/*
+			 * @brief Prefix increment operator, increments the iterator to the next element.
+			 * @return A reference to this iterator.
+			 * @throw std::runtime_error If checked, and the iterator is not initialized or out of range.
+			*/
+			Derived &operator++() noexcept(!Checked) {
+				_checkDereferenceable();
+				++_index;
+				return _derived();
+			}
+
+			/*
+			 * @brief Postfix increment operator, increments the iterator to the next element.
+			 * @return A copy of the iterator before the increment.
+			 * @throw std::runtime_error If checked, and the iterator is not initialized or out of range.
+			*/
+			Derived operator++(int) noexcept(!Checked) {
+				Derived copy(_derived());
+				++(*this);
+				return copy;
+			}
+
+			/*
+			 * @brief Prefix decrement operator, moves the iterator to the previous element.
+			 * @return A reference to this iterator.
+			 * @throw std::runtime_error If checked, and the iterator is not initialized or at the first element.
+			*/
+			Derived &operator--() noexcept(!Checked) {
+				_advance(-1);
+				return _derived();
+			}
+
+			/*
+			 * @brief Postfix decrement operator, moves the iterator to the previous element.
+			 * @return A copy of the iterator before the decrement.
+			 * @throw std::runtime_error If checked, and the iterator is not initialized or at the first element.
+			*/
+			Derived operator--(int) noexcept(!Checked) {
+				Derived copy(_derived());
+				--(*this);
+				return copy;
+			}
+
+			/*
+			 * @brief Compound addition operator, moves the iterator forward by a given offset.
+			 * @param offset The amount of positions to move, may be negative.
+			 * @return A reference to this iterator.
+			 * @throw std::runtime_error If checked, and the iterator is not initialized or would leave the range [begin(), end()].
+			 * @note Time complexity: O(1).
+			*/
+			Derived &operator+=(difference_type offset) noexcept(!Checked) {
+				_advance(offset);
+				return _derived();
+			}
+
+			/*
+			 * @brief Compound subtraction operator, moves the iterator backward by a given offset.
+			 * @param offset The amount of positions to move, may be negative.
+			 * @return A reference to this iterator.
+			 * @throw std::runtime_error If checked, and the iterator is not initialized or would leave the range [begin(), end()].
+			 * @note Time complexity: O(1).
+			*/
+			Derived &operator-=(difference_type offset) noexcept(!Checked) {
+				_advance(-offset);
+				return _derived();
+			}
+
+			/*
+			 * @brief Addition operator, returns an iterator moved forward by a given offset.
+			 * @param iterator The iterator to move from.
+			 * @param offset The amount of positions to move, may be negative.
+			 * @return The moved iterator.
+			 * @throw std::runtime_error If checked, and the iterator is not initialized or would leave the range [begin(), end()].
+			*/
+			friend Derived operator+(Derived iterator, difference_type offset) noexcept(!Checked) {
+				iterator += offset;
+				return iterator;
+			}
+
+			/*
+			 * @brief Addition operator, returns an iterator moved forward by a given offset.
+			 * @param offset The amount of positions to move, may be negative.
+			 * @param iterator The iterator to move from.
+			 * @return The moved iterator.
+			 * @throw std::runtime_error If checked, and the iterator is not initialized or would leave the range [begin(), end()].
+			*/
+			friend Derived operator+(difference_type offset, Derived iterator) noexcept(!Checked) {
+				iterator += offset;
+				return iterator;
+			}
+
+			/*
+			 * @brief Subtraction operator, returns an iterator moved backward by a given offset.
+			 * @param iterator The iterator to move from.
+			 * @param offset The amount of positions to move, may be negative.
+			 * @return The moved iterator.
+			 * @throw std::runtime_error If checked, and the iterator is not initialized or would leave the range [begin(), end()].
+			*/
+			friend Derived operator-(Derived iterator, difference_type offset) noexcept(!Checked) {
+				iterator -= offset;
+				return iterator;
+			}
+
+			/*
+			 * @brief Difference operator, returns the distance between two iterators.
+			 * @param lhs The first iterator.
+			 * @param rhs The second iterator.
+			 * @return The amount of positions from the second iterator to the first.
+			 * @throw std::runtime_error If checked, and one of the iterators is not initialized or they are from different containers.
+			*/
+			friend difference_type operator-(const Derived &lhs, const Derived &rhs) noexcept(!Checked) {
+				_checkComparable(lhs, rhs);
+				return static_cast<difference_type>(lhs._index) - static_cast<difference_type>(rhs._index);
+			}
+
+			/*
+			 * @brief Subscript operator, returns the element at a given offset from the iterator.
+			 * @param offset The offset of the element, may be negative.
+			 * @return The element at the given offset.
+			 * @throw std::runtime_error If checked, and the offset points outside of the order.
+			 * @note Time complexity: O(1).
+			*/
+			reference operator[](difference_type offset) const noexcept(!Checked) {
+				return *(_derived() + offset);
+			}
+
+			/*
+			 * @brief Returns an iterator to the first element in the iterated order.
+			 * @return An iterator to the first element in the iterated order.
+			 * @note If the order is empty, the iterator returned is equal to the iterator returned by end().
+			*/
+			Derived begin() const {
+				return _at(0);
+			}
+
+			/*
+			 * @brief Returns an iterator to the element after the last element in the iterated order.
+			 * @return An iterator to the element after the last element in the iterated order.
+			 * @throw std::runtime_error If checked, and the iterator is not initialized.
+			 * @note This iterator is not dereferenceable.
+			*/
+			Derived end() const noexcept(!Checked) {
+				_checkInitialized();
+				return _at(_derived()._limit());
+			}
+
+			/*
+			 * @brief Returns the amount of elements in the iterated order.
+			 * @return The amount of elements in the iterated order.
+			 * @throw std::runtime_error If checked, and the iterator is not initialized.
+			*/
+			size_t size() const noexcept(!Checked) {
+				_checkInitialized();
+				return _derived()._limit();
+			}
+
+			/*
+			 * @brief Split the rest of the order, from this iterator to end(), into contiguous chunks.
+			 * @param parts The amount of chunks.
+			 * @return Exactly parts pairs of [first, last) iterators, in order, whose sizes differ by at most one.
+			 			When there are fewer elements than parts, some of the chunks are empty.
+			 * @throw std::runtime_error If checked, and the iterator is not initialized.
+			 * @note Meant for handing a traversal to a pool of threads. Each chunk is computed in O(1),
+			 			as the iterators are plain indexes.
+			*/
+			std::vector<std::pair<Derived, Derived>> split(size_t parts) const {
+				_checkInitialized();
+
+				size_t first = _index, count = _derived()._limit() - _index;
+				std::vector<std::pair<Derived, Derived>> chunks;
+				chunks.reserve(parts);
+
+				for (size_t part = 0; part < parts; ++part)
+					chunks.emplace_back(_at(first + count * part / parts), _at(first + count * (part + 1) / parts));
+
+				return chunks;
+			}
+	};
+}
@@ -15,597 +15,432 @@
  *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
-#include <cstdlib>
-#include <cmath>
-#include <memory>
 #include <algorithm>
 #include "MagicalContainer.hpp"
+#include "PrimeSieve.hpp"
+#include "FileFormat.hpp"
+#include <cstdio>
+#include <fstream>
 
 using namespace std;
 using namespace ariel;
 
-void MagicalContainer::addElement(int element) {
-	auto in = _elements.insert(element);
+template <typename T, typename Compare, typename Alloc>
+void BasicMagicalContainer<T, Compare, Alloc>::addElement(T element) {
+	// Locate the insertion point - O(logn), as the elements are sorted.
+	auto it = lower_bound(_elements.begin(), _elements.end(), element, _compare);
 
-	if (in.second)
-	{
-		// Handle prime order - O(n) in this case, as we need to find the correct place to insert the element.
-		if (_isPrime(element))
-		{
-			auto index_to_insert = lower_bound(_elements_prime_order.begin(), _elements_prime_order.end(), &(*in.first), [](const int *a, const int *b) {
-				return *a < *b;
-			});
-
-			_elements_prime_order.insert(index_to_insert, &(*in.first));
-		}
-
-		// Handle ascending order - O(n) in this case, as we need to find the correct place to insert the element.
-		auto index_to_insert = lower_bound(_elements_ascending_order.begin(), _elements_ascending_order.end(), &(*in.first), [](const int *a, const int *b) {
-			return *a < *b;
-		});
-
-		_elements_ascending_order.insert(index_to_insert, &(*in.first));
-
-		// Handle sidecross order - O(n) in this case, as we need to rebuild the vector (Easier than reordering it).
-		_elements_sidecross_order.clear();
-
-		if (size() == 1)
-			_elements_sidecross_order.push_back(_elements_ascending_order.front());
-
-		else
-		{
-			size_t start = 0, end = size() - 1;
-
-			while (start <= end && end != 0)
-			{
-				_elements_sidecross_order.push_back(_elements_ascending_order.at(start));
-
-				if (start != end)
-					_elements_sidecross_order.push_back(_elements_ascending_order.at(end));
-
-				start++;
-				end--;
-			}
-		}
-	}
-}
-
-void MagicalContainer::removeElement(int element) {
-	auto it = _elements.find(element);
-
-	if (it == _elements.end())
-		throw runtime_error("Element not found");
-
-	// Handle prime order - O(n) in this case, as we need to find the element in the vector to remove it.
-	if (_isPrime(element))
-	{
-		auto it_prime = find(_elements_prime_order.begin(), _elements_prime_order.end(), &(*it));
-		_elements_prime_order.erase(it_prime);
-	}
-
-	// Handle ascending order - O(n) in this case, as we need to find the element in the vector to remove it.
-	auto it_ascending = find(_elements_ascending_order.begin(), _elements_ascending_order.end(), &(*it));
-	_elements_ascending_order.erase(it_ascending);
-
-	// Delete the element - O(logn)
-	_elements.erase(element);
-
-	// Handle sidecross order - O(n) in this case, as we need to rebuild the vector (Easier than reordering it).
-	_elements_sidecross_order.clear();
-
-	// Incase the main container is empty, we don't need to rebuild the vector.
-	if (size() == 0)
+	if (it != _elements.end() && _equivalent(*it, element))
 		return;
 
-	_elements_sidecross_order.reserve(_elements.size());
-
-	if (size() == 1)
-		_elements_sidecross_order.push_back(_elements_ascending_order.at(0));
-
-	else
-	{
-		size_t start = 0, end = size() - 1;
-
-		while (start <= end && end != 0)
-		{
-			_elements_sidecross_order.push_back(_elements_ascending_order.at(start));
+	size_t position = static_cast<size_t>(it - _elements.begin());
 
-			if (start != end)
-				_elements_sidecross_order.push_back(_elements_ascending_order.at(end));
+	_checkSize(_elements.size() + 1);
 
-			start++;
-			end--;
-		}
-	}
-}
+	// Handle ascending order - O(n) in this case, as we need to shift the elements after the insertion point.
+	_elements.insert(it, element);
 
-bool MagicalContainer::_isPrime(int num) {
-	if (num <= 1)
-		return false;
+	// Handle the built views - every index at or after the insertion point moves one place forward.
+	if (_prime_order_built.ready())
+		_insertIndex(_elements_prime_order, position, _isPrime(element));
 
-	for (int i = 2; i <= sqrt(num); ++i)
+	for (FilteredView &view : _views)
 	{
-		if (num % i == 0)
-			return false;
+		if (view.built.ready())
+			_insertIndex(view.order, position, view.predicate(element));
 	}
-
-	return true;
 }
 
-MagicalContainer::AscendingIterator::AscendingIterator(const AscendingIterator &other) {
-	if (_container != other._container && _container != nullptr && other._container != nullptr)
-		throw runtime_error("Cannot copy iterators from different containers");
+template <typename T, typename Compare, typename Alloc>
+void BasicMagicalContainer<T, Compare, Alloc>::_insertIndex(index_vector &order, size_t position, bool member) {
+	auto it = lower_bound(order.begin(), order.end(), static_cast<index_type>(position));
 
-	_container = other._container;
-	_index = other._index;
-}
+	for (auto shift = it; shift != order.end(); ++shift)
+		++(*shift);
 
-MagicalContainer::AscendingIterator::AscendingIterator(AscendingIterator &&other) noexcept: _container(other._container), _index(other._index) {
-	other._container = nullptr;
-	other._index = 0;
+	if (member)
+		order.insert(it, static_cast<index_type>(position));
 }
 
-MagicalContainer::AscendingIterator &MagicalContainer::AscendingIterator::operator=(const AscendingIterator &other) {
-	if (this != &other)
-	{
-		if (&_container != &other._container && _container != nullptr && other._container != nullptr)
-			throw runtime_error("Cannot assign iterators from different containers");
+template <typename T, typename Compare, typename Alloc>
+void BasicMagicalContainer<T, Compare, Alloc>::_eraseIndexes(index_vector &order, size_t first, size_t count) {
+	auto erase_first = lower_bound(order.begin(), order.end(), static_cast<index_type>(first));
+	auto erase_last = lower_bound(erase_first, order.end(), static_cast<index_type>(first + count));
 
-		_container = other._container;
-		_index = other._index;
-	}
-
-	return *this;
+	for (auto shift = order.erase(erase_first, erase_last); shift != order.end(); ++shift)
+		*shift -= static_cast<index_type>(count);
 }
 
-MagicalContainer::AscendingIterator &MagicalContainer::AscendingIterator::operator=(AscendingIterator &&other) noexcept {
-	if (this != &other)
-	{
-		_container = other._container;
-		_index = other._index;
+template <typename T, typename Compare, typename Alloc>
+void BasicMagicalContainer<T, Compare, Alloc>::_addBatch(vector<T> batch) {
+	sort(batch.begin(), batch.end(), _compare);
+	batch.erase(unique(batch.begin(), batch.end(), [this](const T &lhs, const T &rhs) { return _equivalent(lhs, rhs); }), batch.end());
 
-		other._container = nullptr;
-		other._index = 0;
-	}
+	if (batch.empty())
+		return;
 
-	return *this;
+	_merge(batch, [&batch](size_t batch_index) {
+		return _isPrime(batch[batch_index]);
+	});
 }
 
-bool MagicalContainer::AscendingIterator::operator==(const IIterator &other) const {
-	const AscendingIterator *other_ptr = dynamic_cast<const AscendingIterator *>(&other);
-
-	if (other_ptr == nullptr)
-		throw runtime_error("Cannot compare iterators of different types");
-
-	else if (_container == nullptr || other_ptr->_container == nullptr)
-		throw runtime_error("One of the iterators is not initialized");
-
-	else if (_container != other_ptr->_container)
-		throw runtime_error("Cannot compare iterators from different containers");
+template <typename T, typename Compare, typename Alloc>
+void BasicMagicalContainer<T, Compare, Alloc>::removeElement(T element) {
+	// Locate the element - O(logn), as the elements are sorted.
+	auto it = lower_bound(_elements.begin(), _elements.end(), element, _compare);
 
-	return _index == other_ptr->_index;
-}
-
-bool MagicalContainer::AscendingIterator::operator!=(const IIterator &other) const {
-	const AscendingIterator *other_ptr = dynamic_cast<const AscendingIterator *>(&other);
+	if (it == _elements.end() || !_equivalent(*it, element))
+		throw runtime_error("Element not found");
 
-	if (other_ptr == nullptr)
-		throw runtime_error("Cannot compare iterators of different types");
+	size_t position = static_cast<size_t>(it - _elements.begin());
 
-	else if (_container == nullptr || other_ptr->_container == nullptr)
-		throw runtime_error("One of the iterators is not initialized");
+	// Handle ascending order - O(n) in this case, as we need to shift the elements after the removed one.
+	_elements.erase(it);
 
-	else if (_container != other_ptr->_container)
-		throw runtime_error("Cannot compare iterators from different containers");
+	// Handle the built views - drop the element's index (if any), and move every later index one place back.
+	// The views that are not built are empty, so this leaves them untouched.
+	_eraseIndexes(_elements_prime_order, position, 1);
 
-	return _index != other_ptr->_index;
+	for (FilteredView &view : _views)
+		_eraseIndexes(view.order, position, 1);
 }
 
-bool MagicalContainer::AscendingIterator::operator<(const IIterator &other) const {
-	const AscendingIterator *other_ptr = dynamic_cast<const AscendingIterator *>(&other);
+template <typename T, typename Compare, typename Alloc>
+size_t BasicMagicalContainer<T, Compare, Alloc>::_removeBatch(vector<T> batch) {
+	sort(batch.begin(), batch.end(), _compare);
+	batch.erase(unique(batch.begin(), batch.end(), [this](const T &lhs, const T &rhs) { return _equivalent(lhs, rhs); }), batch.end());
 
-	if (other_ptr == nullptr)
-		throw runtime_error("Cannot compare iterators of different types");
+	if (batch.empty())
+		return 0;
 
-	else if (_container == nullptr || other_ptr->_container == nullptr)
-		throw runtime_error("One of the iterators is not initialized");
+	// The elements are visited in ascending order, so a single cursor walks the sorted batch alongside them.
+	auto cursor = batch.begin();
 
-	else if (_container != other_ptr->_container)
-		throw runtime_error("Cannot compare iterators from different containers");
+	return _compact([this, &cursor, &batch](const T &element) {
+		while (cursor != batch.end() && _compare(*cursor, element))
+			++cursor;
 
-	return _index < other_ptr->_index;
+		return cursor != batch.end() && _equivalent(*cursor, element);
+	});
 }
 
-bool MagicalContainer::AscendingIterator::operator>(const IIterator &other) const {
-	const AscendingIterator *other_ptr = dynamic_cast<const AscendingIterator *>(&other);
+template <typename T, typename Compare, typename Alloc>
+size_t BasicMagicalContainer<T, Compare, Alloc>::removeRange(T low, T high) {
+	if (!_compare(low, high))
+		return 0;
 
-	if (other_ptr == nullptr)
-		throw runtime_error("Cannot compare iterators of different types");
+	auto first = lower_bound(_elements.begin(), _elements.end(), low, _compare);
+	auto last = lower_bound(first, _elements.end(), high, _compare);
 
-	else if (_container == nullptr || other_ptr->_container == nullptr)
-		throw runtime_error("One of the iterators is not initialized");
+	size_t first_index = static_cast<size_t>(first - _elements.begin());
+	size_t removed = static_cast<size_t>(last - first);
 
-	else if (_container != other_ptr->_container)
-		throw runtime_error("Cannot compare iterators from different containers");
+	if (removed == 0)
+		return 0;
 
-	return _index > other_ptr->_index;
-}
+	_elements.erase(first, last);
 
-bool MagicalContainer::AscendingIterator::operator==(const AscendingIterator &other) const {
-	if (_container == nullptr || other._container == nullptr)
-		throw runtime_error("One of the iterators is not initialized");
+	// Handle the built views - drop the indexes inside the removed block, and move every later index back by its size.
+	_eraseIndexes(_elements_prime_order, first_index, removed);
 
-	else if (_container != other._container)
-		throw runtime_error("Cannot compare iterators from different containers");
+	for (FilteredView &view : _views)
+		_eraseIndexes(view.order, first_index, removed);
 
-	return _index == other._index;
+	return removed;
 }
 
-bool MagicalContainer::AscendingIterator::operator!=(const AscendingIterator &other) const {
-	if (_container == nullptr || other._container == nullptr)
-		throw runtime_error("One of the iterators is not initialized");
+template <typename T, typename Compare, typename Alloc>
+size_t BasicMagicalContainer<T, Compare, Alloc>::_indexOf(T element) const {
+	size_t index = _lowerIndex(element);
 
-	else if (_container != other._container)
-		throw runtime_error("Cannot compare iterators from different containers");
+	if (index == _elements.size() || !_equivalent(_elements[index], element))
+		return _elements.size();
 
-	return _index != other._index;
+	return index;
 }
 
-bool MagicalContainer::AscendingIterator::operator<(const AscendingIterator &other) const {
-	if (_container == nullptr || other._container == nullptr)
-		throw runtime_error("One of the iterators is not initialized");
-
-	else if (_container != other._container)
-		throw runtime_error("Cannot compare iterators from different containers");
-
-	return _index < other._index;
+template <typename T, typename Compare, typename Alloc>
+bool BasicMagicalContainer<T, Compare, Alloc>::contains(T element) const {
+	return binary_search(_elements.begin(), _elements.end(), element, _compare);
 }
 
-bool MagicalContainer::AscendingIterator::operator>(const AscendingIterator &other) const {
-	if (_container == nullptr || other._container == nullptr)
-		throw runtime_error("One of the iterators is not initialized");
-
-	else if (_container != other._container)
-		throw runtime_error("Cannot compare iterators from different containers");
-
-	return _index > other._index;
+template <typename T, typename Compare, typename Alloc>
+size_t BasicMagicalContainer<T, Compare, Alloc>::_lowerIndex(T value) const {
+	return static_cast<size_t>(lower_bound(_elements.begin(), _elements.end(), value, _compare) - _elements.begin());
 }
 
-int MagicalContainer::AscendingIterator::operator*() const {
-	if (_container == nullptr)
-		throw runtime_error("Iterator not initialized");
+template <typename T, typename Compare, typename Alloc>
+size_t BasicMagicalContainer<T, Compare, Alloc>::_lowerPrimeIndex(T value) const {
+	// The prime order is sorted by value as well, so it can be binary searched through the indexes.
+	const index_vector &prime_order = _primeOrder();
 
-	else if (_index >= _container->_elements_ascending_order.size())
-		throw runtime_error("Iterator out of range");
+	auto it = lower_bound(prime_order.begin(), prime_order.end(), value, [this](size_t index, const T &other) {
+		return _compare(_elements[index], other);
+	});
 
-	return *(_container->_elements_ascending_order.at(_index));
+	return static_cast<size_t>(it - prime_order.begin());
 }
 
-MagicalContainer::AscendingIterator &MagicalContainer::AscendingIterator::operator++() {
-	if (_container == nullptr)
-		throw runtime_error("Iterator not initialized");
-
-	else if (_index >= _container->_elements_ascending_order.size())
-		throw runtime_error("Iterator out of range");
-
-	++_index;
-	return *this;
+template <typename T, typename Compare, typename Alloc>
+size_t BasicMagicalContainer<T, Compare, Alloc>::_upperIndex(T value) const {
+	return static_cast<size_t>(upper_bound(_elements.begin(), _elements.end(), value, _compare) - _elements.begin());
 }
 
-MagicalContainer::SideCrossIterator::SideCrossIterator(const SideCrossIterator &other) {
-	if (_container != other._container && _container != nullptr && other._container != nullptr)
-		throw runtime_error("Cannot copy iterators from different containers");
+template <typename T, typename Compare, typename Alloc>
+size_t BasicMagicalContainer<T, Compare, Alloc>::_upperPrimeIndex(T value) const {
+	const index_vector &prime_order = _primeOrder();
 
-	_container = other._container;
-	_index = other._index;
-}
+	auto it = upper_bound(prime_order.begin(), prime_order.end(), value, [this](const T &other, size_t index) {
+		return _compare(other, _elements[index]);
+	});
 
-MagicalContainer::SideCrossIterator::SideCrossIterator(SideCrossIterator &&other) noexcept: _container(other._container), _index(other._index) {
-	other._container = nullptr;
-	other._index = 0;
+	return static_cast<size_t>(it - prime_order.begin());
 }
 
-MagicalContainer::SideCrossIterator &MagicalContainer::SideCrossIterator::operator=(const SideCrossIterator &other) {
-	if (this != &other)
-	{
-		if (&_container != &other._container)
-			throw runtime_error("Cannot assign iterators from different containers");
-		
-		_index = other._index;
-	}
-
-	return *this;
+template <typename T, typename Compare, typename Alloc>
+size_t BasicMagicalContainer<T, Compare, Alloc>::countInRange(T low, T high) const {
+	return _compare(low, high) ? _lowerIndex(high) - _lowerIndex(low) : 0;
 }
 
-MagicalContainer::SideCrossIterator &MagicalContainer::SideCrossIterator::operator=(SideCrossIterator &&other) noexcept {
-	if (this != &other)
-	{
-		_container = other._container;
-		_index = other._index;
-	}
-
-	return *this;
+template <typename T, typename Compare, typename Alloc>
+size_t BasicMagicalContainer<T, Compare, Alloc>::countPrimesInRange(T low, T high) const {
+	return _compare(low, high) ? _lowerPrimeIndex(high) - _lowerPrimeIndex(low) : 0;
 }
 
-bool MagicalContainer::SideCrossIterator::operator==(const IIterator &other) const {
-	const SideCrossIterator *other_ptr = dynamic_cast<const SideCrossIterator *>(&other);
-
-	if (other_ptr == nullptr)
-		throw runtime_error("Cannot compare iterators of different types");
-
-	else if (_container == nullptr || other_ptr->_container == nullptr)
-		throw runtime_error("One of the iterators is not initialized");
+template <typename T, typename Compare, typename Alloc>
+T BasicMagicalContainer<T, Compare, Alloc>::nthAscending(size_t k) const {
+	if (k >= _elements.size())
+		throw runtime_error("Index out of range");
 
-	else if (_container != other_ptr->_container)
-		throw runtime_error("Cannot compare iterators from different containers");
-
-	return _index == other_ptr->_index;
+	return _elements[k];
 }
 
-bool MagicalContainer::SideCrossIterator::operator!=(const IIterator &other) const {
-	const SideCrossIterator *other_ptr = dynamic_cast<const SideCrossIterator *>(&other);
-
-	if (other_ptr == nullptr)
-		throw runtime_error("Cannot compare iterators of different types");
-
-	else if (_container == nullptr || other_ptr->_container == nullptr)
-		throw runtime_error("One of the iterators is not initialized");
-
-	else if (_container != other_ptr->_container)
-		throw runtime_error("Cannot compare iterators from different containers");
+template <typename T, typename Compare, typename Alloc>
+T BasicMagicalContainer<T, Compare, Alloc>::nthSideCross(size_t k) const {
+	if (k >= _elements.size())
+		throw runtime_error("Index out of range");
 
-	return _index != other_ptr->_index;
+	return _elements[sideCrossToAscending(k, _elements.size())];
 }
 
-bool MagicalContainer::SideCrossIterator::operator<(const IIterator &other) const {
-	const SideCrossIterator *other_ptr = dynamic_cast<const SideCrossIterator *>(&other);
+template <typename T, typename Compare, typename Alloc>
+T BasicMagicalContainer<T, Compare, Alloc>::nthPrime(size_t k) const {
+	const index_vector &prime_order = _primeOrder();
 
-	if (other_ptr == nullptr)
-		throw runtime_error("Cannot compare iterators of different types");
+	if (k >= prime_order.size())
+		throw runtime_error("Index out of range");
 
-	else if (_container == nullptr || other_ptr->_container == nullptr)
-		throw runtime_error("One of the iterators is not initialized");
-
-	else if (_container != other_ptr->_container)
-		throw runtime_error("Cannot compare iterators from different containers");
-
-	return _index < other_ptr->_index;
+	return _elements[prime_order[k]];
 }
 
-bool MagicalContainer::SideCrossIterator::operator>(const IIterator &other) const {
-	const SideCrossIterator *other_ptr = dynamic_cast<const SideCrossIterator *>(&other);
-
-	if (other_ptr == nullptr)
-		throw runtime_error("Cannot compare iterators of different types");
-
-	else if (_container == nullptr || other_ptr->_container == nullptr)
-		throw runtime_error("One of the iterators is not initialized");
-
-	else if (_container != other_ptr->_container)
-		throw runtime_error("Cannot compare iterators from different containers");
-
-	return _index > other_ptr->_index;
+template <typename T, typename Compare, typename Alloc>
+size_t BasicMagicalContainer<T, Compare, Alloc>::rankOf(T value) const {
+	return _lowerIndex(value);
 }
 
-bool MagicalContainer::SideCrossIterator::operator==(const SideCrossIterator &other) const {
-	if (_container == nullptr || other._container == nullptr)
-		throw runtime_error("One of the iterators is not initialized");
-
-	else if (_container != other._container)
-		throw runtime_error("Cannot compare iterators from different containers");
-
-	return _index == other._index;
+template <typename T, typename Compare, typename Alloc>
+size_t BasicMagicalContainer<T, Compare, Alloc>::primeRankOf(T value) const {
+	return _lowerPrimeIndex(value);
 }
 
-bool MagicalContainer::SideCrossIterator::operator!=(const SideCrossIterator &other) const {
-	if (_container == nullptr || other._container == nullptr)
-		throw runtime_error("One of the iterators is not initialized");
+template <typename T, typename Compare, typename Alloc>
+size_t BasicMagicalContainer<T, Compare, Alloc>::sideCrossRankOf(T element) const {
+	size_t index = _indexOf(element);
 
-	else if (_container != other._container)
-		throw runtime_error("Cannot compare iterators from different containers");
+	if (index == _elements.size())
+		throw runtime_error("Element not found");
 
-	return _index != other._index;
+	return ascendingToSideCross(index, _elements.size());
 }
 
-bool MagicalContainer::SideCrossIterator::operator<(const SideCrossIterator &other) const {
-	if (_container == nullptr || other._container == nullptr)
-		throw runtime_error("One of the iterators is not initialized");
-
-	else if (_container != other._container)
-		throw runtime_error("Cannot compare iterators from different containers");
-
-	return _index < other._index;
+template <typename T, typename Compare, typename Alloc>
+void BasicMagicalContainer<T, Compare, Alloc>::_invalidateViews() {
+	for (FilteredView &view : _views)
+	{
+		view.order.clear();
+		view.built.set(false);
+	}
 }
 
-bool MagicalContainer::SideCrossIterator::operator>(const SideCrossIterator &other) const {
-	if (_container == nullptr || other._container == nullptr)
-		throw runtime_error("One of the iterators is not initialized");
+template <typename T, typename Compare, typename Alloc>
+auto BasicMagicalContainer<T, Compare, Alloc>::_primeOrder() const -> const index_vector & {
+	// A build that threw leaves a partial order behind, so every build starts from scratch.
+	_prime_order_built.buildOnce([this]() {
+		_elements_prime_order.clear();
 
-	else if (_container != other._container)
-		throw runtime_error("Cannot compare iterators from different containers");
+		for (size_t index = 0; index < _elements.size(); ++index)
+		{
+			if (_isPrime(_elements[index]))
+				_elements_prime_order.push_back(static_cast<index_type>(index));
+		}
+	});
 
-	return _index > other._index;
+	return _elements_prime_order;
 }
 
-int MagicalContainer::SideCrossIterator::operator*() const {
-	if (_container == nullptr)
-		throw runtime_error("Iterator not initialized");
+template <typename T, typename Compare, typename Alloc>
+auto BasicMagicalContainer<T, Compare, Alloc>::_viewOrder(size_t view) const -> const index_vector & {
+	if (view >= _views.size())
+		throw runtime_error("View not found");
 
-	else if (_index >= _container->_elements_ascending_order.size())
-		throw runtime_error("Iterator out of range");
+	const FilteredView &filtered = _views[view];
 
-	return *(_container->_elements_sidecross_order.at(_index));
-}
-
-MagicalContainer::SideCrossIterator &MagicalContainer::SideCrossIterator::operator++() {
-	if (_container == nullptr)
-		throw runtime_error("Iterator not initialized");
+	filtered.built.buildOnce([this, &filtered]() {
+		filtered.order.clear();
 
-	else if (_index >= _container->_elements_sidecross_order.size())
-		throw runtime_error("Iterator out of range");
+		for (size_t index = 0; index < _elements.size(); ++index)
+		{
+			if (filtered.predicate(_elements[index]))
+				filtered.order.push_back(static_cast<index_type>(index));
+		}
+	});
 
-	++_index;
-	return *this;
+	return filtered.order;
 }
 
-MagicalContainer::PrimeIterator::PrimeIterator(const PrimeIterator &other) {
-	if (_container != other._container && _container != nullptr && other._container != nullptr)
-		throw runtime_error("Cannot copy iterators from different containers");
+template <typename T, typename Compare, typename Alloc>
+void BasicMagicalContainer<T, Compare, Alloc>::materializeViews() const {
+	_primeOrder();
 
-	_container = other._container;
-	_index = other._index;
+	for (size_t view = 0; view < _views.size(); ++view)
+		_viewOrder(view);
 }
 
-MagicalContainer::PrimeIterator::PrimeIterator(PrimeIterator &&other) noexcept: _container(other._container), _index(other._index) {
-	other._container = nullptr;
-	other._index = 0;
-}
-
-MagicalContainer::PrimeIterator &MagicalContainer::PrimeIterator::operator=(const PrimeIterator &other) {
-	if (this != &other)
+template <typename T, typename Compare, typename Alloc>
+size_t BasicMagicalContainer<T, Compare, Alloc>::addView(string name, function<bool(const T &)> predicate) {
+	for (const FilteredView &view : _views)
 	{
-		if (_container != other._container && _container != nullptr && other._container != nullptr)
-		{
-			throw runtime_error("Cannot assign iterators from different containers");
-		}
-
-		_container = other._container;
-		_index = other._index;
+		if (view.name == name)
+			throw runtime_error("View already exists");
 	}
 
-	return *this;
+	_views.push_back(FilteredView{move(name), move(predicate), index_vector(_elements_prime_order.get_allocator()), {}});
+
+	return _views.size() - 1;
 }
 
-MagicalContainer::PrimeIterator &MagicalContainer::PrimeIterator::operator=(PrimeIterator &&other) noexcept {
-	if (this != &other)
+template <typename T, typename Compare, typename Alloc>
+size_t BasicMagicalContainer<T, Compare, Alloc>::viewId(const string &name) const {
+	for (size_t view = 0; view < _views.size(); ++view)
 	{
-		_container = other._container;
-		_index = other._index;
-
-		other._container = nullptr;
-		other._index = 0;
+		if (_views[view].name == name)
+			return view;
 	}
 
-	return *this;
+	throw runtime_error("View not found");
 }
 
-bool MagicalContainer::PrimeIterator::operator==(const IIterator &other) const {
-	const PrimeIterator *other_ptr = dynamic_cast<const PrimeIterator *>(&other);
-
-	if (other_ptr == nullptr)
-		throw runtime_error("Cannot compare iterators of different types");
-
-	else if (_container == nullptr || other_ptr->_container == nullptr)
-		throw runtime_error("One of the iterators is not initialized");
-
-	else if (_container != other_ptr->_container)
-		throw runtime_error("Cannot compare iterators from different containers");
-
-	return _index == other_ptr->_index;
+template <typename T, typename Compare, typename Alloc>
+size_t BasicMagicalContainer<T, Compare, Alloc>::viewSize(size_t view) const {
+	return _viewOrder(view).size();
 }
 
-bool MagicalContainer::PrimeIterator::operator!=(const IIterator &other) const {
-	const PrimeIterator *other_ptr = dynamic_cast<const PrimeIterator *>(&other);
+template <typename T, typename Compare, typename Alloc>
+T BasicMagicalContainer<T, Compare, Alloc>::nthInView(size_t view, size_t k) const {
+	const index_vector &order = _viewOrder(view);
 
-	if (other_ptr == nullptr)
-		throw runtime_error("Cannot compare iterators of different types");
+	if (k >= order.size())
+		throw runtime_error("Index out of range");
 
-	else if (_container == nullptr || other_ptr->_container == nullptr)
-		throw runtime_error("One of the iterators is not initialized");
-
-	else if (_container != other_ptr->_container)
-		throw runtime_error("Cannot compare iterators from different containers");
-
-	return _index != other_ptr->_index;
+	return _elements[order[k]];
 }
 
-bool MagicalContainer::PrimeIterator::operator<(const IIterator &other) const {
-	const PrimeIterator *other_ptr = dynamic_cast<const PrimeIterator *>(&other);
+template <typename T, typename Compare, typename Alloc>
+void BasicMagicalContainer<T, Compare, Alloc>::save(const string &path) const {
+	const index_vector &prime_order = _primeOrder();
+	FileHeader header = FileHeader::make<T, Compare, index_type>(_elements.size(), prime_order.size());
 
-	if (other_ptr == nullptr)
-		throw runtime_error("Cannot compare iterators of different types");
+	// Write a temporary file next to the target and rename it over the target once it is complete, so readers
+	// and existing mappings of the old file never see a partially written one.
+	const string temp_path = path + ".tmp";
+	ofstream file(temp_path, ios::binary | ios::trunc);
 
-	else if (_container == nullptr || other_ptr->_container == nullptr)
-		throw runtime_error("One of the iterators is not initialized");
+	if (!file)
+		throw runtime_error("Cannot open file for writing");
 
-	else if (_container != other_ptr->_container)
-		throw runtime_error("Cannot compare iterators from different containers");
-
-	return _index < other_ptr->_index;
-}
+	const char padding[FileHeader::ALIGNMENT] = {};
 
-bool MagicalContainer::PrimeIterator::operator>(const IIterator &other) const {
-	const PrimeIterator *other_ptr = dynamic_cast<const PrimeIterator *>(&other);
+	file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+	file.write(padding, static_cast<streamsize>(header.elements_offset - sizeof(header)));
+	file.write(reinterpret_cast<const char *>(_elements.data()), static_cast<streamsize>(_elements.size() * sizeof(T)));
+	file.write(padding, static_cast<streamsize>(header.primes_offset - header.elements_offset - _elements.size() * sizeof(T)));
+	file.write(reinterpret_cast<const char *>(prime_order.data()), static_cast<streamsize>(prime_order.size() * sizeof(index_type)));
+	file.flush();
+	file.close();
 
-	if (other_ptr == nullptr)
-		throw runtime_error("Cannot compare iterators of different types");
-
-	else if (_container == nullptr || other_ptr->_container == nullptr)
-		throw runtime_error("One of the iterators is not initialized");
-
-	else if (_container != other_ptr->_container)
-		throw runtime_error("Cannot compare iterators from different containers");
+	if (!file)
+	{
+		remove(temp_path.c_str());
+		throw runtime_error("Cannot write file");
+	}
 
-	return _index > other_ptr->_index;
+	if (rename(temp_path.c_str(), path.c_str()) != 0)
+	{
+		remove(temp_path.c_str());
+		throw runtime_error("Cannot replace file");
+	}
 }
 
-bool MagicalContainer::PrimeIterator::operator==(const PrimeIterator &other) const {
-	if (_container == nullptr)
-		throw runtime_error("Iterator not initialized");
+template <typename T, typename Compare, typename Alloc>
+void BasicMagicalContainer<T, Compare, Alloc>::load(const string &path) {
+	ifstream file(path, ios::binary | ios::ate);
 
-	else if (_container != other._container)
-		throw runtime_error("Cannot compare iterators from different containers");
+	if (!file)
+		throw runtime_error("Cannot open file for reading");
 
-	return _index == other._index;
-}
+	uint64_t file_size = static_cast<uint64_t>(file.tellg());
+	FileHeader header {};
 
-bool MagicalContainer::PrimeIterator::operator!=(const PrimeIterator &other) const {
-	if (_container == nullptr || other._container == nullptr)
-		throw runtime_error("One of the iterators is not initialized");
+	file.seekg(0);
 
-	else if (_container != other._container)
-		throw runtime_error("Cannot compare iterators from different containers");
+	if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)))
+		throw runtime_error("Not a container snapshot file");
 
-	return _index != other._index;
-}
+	header.validate<T, Compare, index_type>(file_size);
+	_checkSize(header.count);
 
-bool MagicalContainer::PrimeIterator::operator<(const PrimeIterator &other) const {
-	if (_container == nullptr || other._container == nullptr)
-		throw runtime_error("One of the iterators is not initialized");
+	vector<T, Alloc> elements(static_cast<size_t>(header.count), _elements.get_allocator());
+	index_vector prime_order(static_cast<size_t>(header.prime_count), _elements_prime_order.get_allocator());
 
-	else if (_container != other._container)
-		throw runtime_error("Cannot compare iterators from different containers");
+	file.seekg(static_cast<streamoff>(header.elements_offset));
+	file.read(reinterpret_cast<char *>(elements.data()), static_cast<streamsize>(elements.size() * sizeof(T)));
+	file.seekg(static_cast<streamoff>(header.primes_offset));
+	file.read(reinterpret_cast<char *>(prime_order.data()), static_cast<streamsize>(prime_order.size() * sizeof(index_type)));
 
-	return _index < other._index;
-}
+	if (!file)
+		throw runtime_error("Snapshot file is truncated or corrupted");
 
-bool MagicalContainer::PrimeIterator::operator>(const PrimeIterator &other) const {
-	if (_container == nullptr || other._container == nullptr)
-		throw runtime_error("One of the iterators is not initialized");
+	// The invariants are checked, not rebuilt: the elements must be unique and sorted, and the prime order strictly increasing.
+	for (size_t index = 1; index < elements.size(); ++index)
+	{
+		if (!_compare(elements[index - 1], elements[index]))
+			throw runtime_error("Snapshot file is truncated or corrupted");
+	}
 
-	else if (_container != other._container)
-		throw runtime_error("Cannot compare iterators from different containers");
+	for (size_t index = 0; index < prime_order.size(); ++index)
+	{
+		if (prime_order[index] >= elements.size() || (index != 0 && prime_order[index] <= prime_order[index - 1]))
+			throw runtime_error("Snapshot file is truncated or corrupted");
+	}
 
-	return _index > other._index;
+	_elements.swap(elements);
+	_elements_prime_order.swap(prime_order);
+	_prime_order_built.set(true);
+	_invalidateViews();
 }
 
-int MagicalContainer::PrimeIterator::operator*() const {
-	if (_container == nullptr)
-		throw runtime_error("Iterator not initialized");
-
-	else if (_index >= _container->_elements_ascending_order.size())
-		throw runtime_error("Iterator out of range");
-
-	return *(_container->_elements_prime_order.at(_index));
+template <typename T, typename Compare, typename Alloc>
+bool BasicMagicalContainer<T, Compare, Alloc>::_isPrime(T num) {
+	return PrimeSieve::isPrime(num);
 }
 
-MagicalContainer::PrimeIterator &MagicalContainer::PrimeIterator::operator++() {
-	if (_container == nullptr)
-		throw runtime_error("Iterator not initialized");
-
-	else if (_index >= _container->_elements_prime_order.size())
-		throw runtime_error("Iterator out of range");
-
-	++_index;
-	return *this;
-}
\ No newline at end of file
+// Keep in sync with IS_SUPPORTED_CONTAINER in MagicalContainer.hpp.
+namespace ariel
+{
+	template class BasicMagicalContainer<int16_t>;
+	template class BasicMagicalContainer<int>;
+	template class BasicMagicalContainer<int, std::greater<int>>;
+	template class BasicMagicalContainer<int64_t>;
+	template class BasicMagicalContainer<uint64_t>;
+	template class BasicMagicalContainer<int, std::less<int>, std::pmr::polymorphic_allocator<int>>;
+}
@@ -17,13 +17,34 @@
 
 #pragma once
 
-#include "IIterator.hpp"
-#include <set>
+#include "IndexIterator.hpp"
+#include <atomic>
+#include <mutex>
 #include <vector>
+#include <memory>
+#include <memory_resource>
+#include <functional>
+#include <string>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
 #include <stdexcept>
+#include <cstdint>
+#include <limits>
 
 namespace ariel
 {
+	/*
+	 * @brief Whether BasicMagicalContainer's member functions are compiled for a given instantiation.
+	 * @note Must match the explicit instantiations at the end of MagicalContainer.cpp, as the definitions are not in this header.
+	*/
+	template <typename T, typename Compare, typename Alloc>
+	inline constexpr bool IS_SUPPORTED_CONTAINER =
+		(std::is_same_v<Compare, std::less<T>> && std::is_same_v<Alloc, std::allocator<T>> &&
+			(std::is_same_v<T, int16_t> || std::is_same_v<T, int> || std::is_same_v<T, int64_t> || std::is_same_v<T, uint64_t>)) ||
+		(std::is_same_v<T, int> && std::is_same_v<Compare, std::greater<int>> && std::is_same_v<Alloc, std::allocator<int>>) ||
+		(std::is_same_v<T, int> && std::is_same_v<Compare, std::less<int>> && std::is_same_v<Alloc, std::pmr::polymorphic_allocator<int>>);
+
 	/*
 	 * @brief In the ancient kingdom of Iteratia, there exists a magical container that has the power to
 	 			hold different types of mystical elements. These elements have various properties and abilities
@@ -33,66 +54,677 @@ namespace ariel
 				orders of traversal through the container, revealing different aspects of the mystical elements.
 				The kingdom is now in turmoil, and the wise King seeks the help of a talented programmer to
 				rediscover the power of these iterators.
-	 * @note The container is implemented as a set of integers.
+	 * @tparam T The element type, one of int16_t, int, int64_t and uint64_t (see IS_SUPPORTED_CONTAINER).
+	 * @tparam Compare The strict weak ordering that defines the container's ascending order.
+	 * @tparam Alloc The allocator for the element storage, rebound for the index vectors.
+	 * @note The container is implemented as a sorted array of unique integers.
+	 * @note The member functions are defined in MagicalContainer.cpp, and explicitly instantiated there only for the
+	 			combinations listed in IS_SUPPORTED_CONTAINER. Any other combination is rejected at compile time.
 	*/
-	class MagicalContainer
+	template <typename T = int, typename Compare = std::less<T>, typename Alloc = std::allocator<T>>
+	class BasicMagicalContainer
 	{
+		static_assert(IS_SUPPORTED_CONTAINER<T, Compare, Alloc>, "BasicMagicalContainer is only instantiated for int16_t, int, int64_t "
+			"and uint64_t with the default ordering and allocator, and for int with std::greater or a polymorphic allocator");
+
+		public:
+			using value_type = T;
+			using key_compare = Compare;
+			using allocator_type = Alloc;
+
+			/*
+			 * @brief The type of the positions stored in the prime order and the filtered views.
+			 * @note 32-bit positions take half the memory of size_t ones, so twice as many fit in a cache line.
+			*/
+			using index_type = uint32_t;
+
+			/*
+			 * @brief The maximum amount of elements the container can hold, as every position must fit in index_type.
+			*/
+			static constexpr size_t MAX_SIZE = std::numeric_limits<index_type>::max();
+
 		private:
 			/*
-			 * @brief The container's elements.
-			 * @note The elements are stored in a set to ensure uniqueness and sorted order.
+			 * @brief The parallel builder fills the storage and the prime order directly.
+			*/
+			friend class ParallelBuilder;
+
+			/*
+			 * @brief The container's elements, kept unique and sorted in ascending order.
+			 * @note The elements are stored contiguously, so ascending traversal is a linear read.
+			*/
+			std::vector<T, Alloc> _elements;
+
+			/*
+			 * @brief A vector of indexes into _elements, allocated with the container's allocator.
+			*/
+			using index_vector = std::vector<index_type, typename std::allocator_traits<Alloc>::template rebind_alloc<index_type>>;
+
+			/*
+			 * @brief Make sure the container can hold a given amount of elements.
+			 * @param count The amount of elements.
+			 * @throw std::runtime_error If count is bigger than MAX_SIZE.
+			*/
+			static void _checkSize(size_t count) {
+				if (count > MAX_SIZE)
+					throw std::runtime_error("Container size limit exceeded");
+			}
+
+			/*
+			 * @brief The built flag of a lazily built order, with the lock that serializes building it.
+			 * @note Const member functions may build an order from several threads at once. The flag is checked
+			 			without the lock first, and set only after the order is built, under the lock.
+						A thread that sees it set also sees the built order.
+			 * @note Copying copies the flag only, every copy has its own lock.
+			*/
+			class BuildFlag
+			{
+				private:
+					std::atomic<bool> _ready {false};
+					std::mutex _lock;
+
+				public:
+					BuildFlag() = default;
+					~BuildFlag() = default;
+
+					BuildFlag(const BuildFlag &other) noexcept: _ready(other.ready()) { }
+
+					BuildFlag &operator=(const BuildFlag &other) noexcept {
+						set(other.ready());
+						return *this;
+					}
+
+					/*
+					 * @brief Checks if the order is built.
+					 * @return True if the order is built.
+					*/
+					bool ready() const noexcept {
+						return _ready.load(std::memory_order_acquire);
+					}
+
+					/*
+					 * @brief Mark the order as built or not, from a non-const member function.
+					 * @param ready Whether the order is built.
+					*/
+					void set(bool ready) noexcept {
+						_ready.store(ready, std::memory_order_release);
+					}
+
+					/*
+					 * @brief Build the order, unless it is built already or another thread builds it first.
+					 * @param build A callable that builds the order.
+					 * @note If build throws, the flag stays unset and the next call tries again.
+					*/
+					template <typename Build>
+					void buildOnce(Build build) {
+						if (ready())
+							return;
+
+						std::lock_guard<std::mutex> lock(_lock);
+
+						if (!_ready.load(std::memory_order_relaxed))
+						{
+							build();
+							set(true);
+						}
+					}
+			};
+
+			/*
+			 * @brief The container's elements indexes in ascending order, with prime numbers only.
+			 * @note Each entry is an index into _elements, so the view stays valid when _elements reallocates.
+			 * @note Built lazily on first use (see _primeOrder), and maintained incrementally from then on.
+			 			While it is not built it is kept empty, so the single-pass bulk operations skip it for free.
+			*/
+			mutable index_vector _elements_prime_order;
+
+			/*
+			 * @brief Whether _elements_prime_order is built (the view's dirty flag, inverted).
+			*/
+			mutable BuildFlag _prime_order_built;
+
+			/*
+			 * @brief The ordering of the elements.
+			*/
+			[[no_unique_address]] Compare _compare;
+
+			/*
+			 * @brief Checks if two values are equivalent under the container's ordering.
+			 * @param lhs The first value.
+			 * @param rhs The second value.
+			 * @return True if neither value is ordered before the other.
+			*/
+			bool _equivalent(const T &lhs, const T &rhs) const {
+				return !_compare(lhs, rhs) && !_compare(rhs, lhs);
+			}
+
+			/*
+			 * @brief A named filtered view, maintained alongside the prime order.
 			*/
-			std::set<int> _elements;
+			struct FilteredView
+			{
+				/*
+				 * @brief The name the view was registered with.
+				*/
+				std::string name;
+
+				/*
+				 * @brief Decides which elements belong to the view.
+				*/
+				std::function<bool(const T &)> predicate;
+
+				/*
+				 * @brief The indexes of the view's elements in ascending order, like _elements_prime_order.
+				 * @note Built lazily on first use, like _elements_prime_order, and kept empty until then.
+				*/
+				mutable index_vector order;
+
+				/*
+				 * @brief Whether order is built.
+				*/
+				mutable BuildFlag built;
+			};
 
 			/*
-			 * @brief The container's elements pointers in ascending order.
-			 * @note The elements are stored in a vector to allow random access and fast iteration.
+			 * @brief The registered filtered views, indexed by their id.
+			 * @note Views are never unregistered, so an id stays valid for the container's lifetime.
 			*/
-			std::vector<const int *> _elements_ascending_order;
+			std::vector<FilteredView> _views;
 
 			/*
-			 * @brief The container's elements pointers in sidecross order.
-			 * @note The elements are stored in a vector to allow random access and fast iteration.
+			 * @brief Insert an element's index into an order, after the element was inserted into _elements.
+			 * @param order The order to update.
+			 * @param position The index the element was inserted at.
+			 * @param member True if the element belongs to the order.
+			 * @note Every index at or after the insertion point moves one place forward. Time complexity: O(m),
+			 			where m is the size of the order.
 			*/
-			std::vector<const int *> _elements_sidecross_order;
+			static void _insertIndex(index_vector &order, size_t position, bool member);
 
 			/*
-			 * @brief The container's elements pointers in ascending order, with prime numbers only.
-			 * @note The elements are stored in a vector to allow random access and fast iteration.
+			 * @brief Drop a block of indexes from an order, after the block was erased from _elements.
+			 * @param order The order to update.
+			 * @param first The index of the first erased element.
+			 * @param count The amount of erased elements.
+			 * @note Every later index moves back by count. Time complexity: O(m), where m is the size of the order.
 			*/
-			std::vector<const int *> _elements_prime_order;
+			static void _eraseIndexes(index_vector &order, size_t first, size_t count);
+
+			/*
+			 * @brief Drop every filtered view's order, to be rebuilt on its next use.
+			 * @note Used when the storage is replaced as a whole. Time complexity: O(v), where v is the amount of views.
+			*/
+			void _invalidateViews();
+
+			/*
+			 * @brief Get the prime order, building it first if it is not built yet.
+			 * @return The prime order.
+			 * @note Time complexity: O(n) on first use, O(1) afterwards.
+			*/
+			const index_vector &_primeOrder() const;
+
+			/*
+			 * @brief Get a filtered view's order, building it first if it is not built yet.
+			 * @param view The id of the view.
+			 * @return The view's order.
+			 * @throw std::runtime_error If there is no view with that id.
+			 * @note Time complexity: O(n) on first use, O(1) afterwards.
+			*/
+			const index_vector &_viewOrder(size_t view) const;
+
+			/*
+			 * @brief Find the index of an element in ascending order.
+			 * @param element The element to find.
+			 * @return The index of the element, or size() if the element does not exist in the container.
+			 * @note Time complexity: O(log n).
+			*/
+			size_t _indexOf(T element) const;
+
+			/*
+			 * @brief Find the first index in ascending order whose element is not less than a given value.
+			 * @param value The value to compare to.
+			 * @return The index of the first element not less than the value, or size() if there is none.
+			 * @note Time complexity: O(log n).
+			*/
+			size_t _lowerIndex(T value) const;
+
+			/*
+			 * @brief Find the first position in prime order whose element is not less than a given value.
+			 * @param value The value to compare to.
+			 * @return The position of the first prime not less than the value, or the amount of primes if there is none.
+			 * @note Time complexity: O(log p), where p is the amount of primes in the container.
+			*/
+			size_t _lowerPrimeIndex(T value) const;
+
+			/*
+			 * @brief Find the first index in ascending order whose element is greater than a given value.
+			 * @param value The value to compare to.
+			 * @return The index of the first element greater than the value, or size() if there is none.
+			 * @note Time complexity: O(log n).
+			*/
+			size_t _upperIndex(T value) const;
+
+			/*
+			 * @brief Find the first position in prime order whose element is greater than a given value.
+			 * @param value The value to compare to.
+			 * @return The position of the first prime greater than the value, or the amount of primes if there is none.
+			 * @note Time complexity: O(log p), where p is the amount of primes in the container.
+			*/
+			size_t _upperPrimeIndex(T value) const;
 
 			/*
 			 * @brief Checks if a given number is prime.
 			 * @param num The number to check.
 			 * @return True if the number is prime, false otherwise.
 			 * @note We assume that the number is positive, any negative number will return false.
+			 * @note The classification is delegated to PrimeSieve.
 			*/
-			static bool _isPrime(int num);
+			static bool _isPrime(T num);
+
+			/*
+			 * @brief Merge a batch of elements into the container.
+			 * @param batch The elements to add, in any order and possibly with duplicates.
+			 * @note The batch is sorted and deduplicated once, then merged with the existing elements
+			 			and their prime order in a single linear pass.
+			 * @note Time complexity: O(k log k + n), where k is the batch size.
+			*/
+			void _addBatch(std::vector<T> batch);
+
+			/*
+			 * @brief Merge a sorted batch of unique elements into the container, in a single linear pass.
+			 * @param batch The elements to add, sorted in ascending order and without duplicates.
+			 * @param is_prime A callable that takes an index into the batch and returns true if that element is prime.
+			 			It is only called for elements that do not already exist in the container, in ascending order,
+						and only if the prime order is built.
+			 * @note The known prime and view indexes of the existing elements are carried along, not recomputed.
+			 * @note Time complexity: O(k + n), where k is the batch size.
+			*/
+			template <typename IsPrime>
+			void _merge(const std::vector<T> &batch, IsPrime is_prime) {
+				std::vector<T, Alloc> merged(_elements.get_allocator());
+				index_vector merged_prime_order(_elements_prime_order.get_allocator());
+
+				merged.reserve(_elements.size() + batch.size());
+				merged_prime_order.reserve(_elements_prime_order.size());
+
+				std::vector<index_vector> merged_views;
+				std::vector<size_t> view_index(_views.size(), 0);
+
+				merged_views.reserve(_views.size());
+
+				for (const FilteredView &view : _views)
+				{
+					merged_views.emplace_back(view.order.get_allocator());
+					merged_views.back().reserve(view.order.size());
+				}
+
+				size_t old_index = 0, batch_index = 0, prime_index = 0;
+
+				while (old_index < _elements.size() || batch_index < batch.size())
+				{
+					if (batch_index == batch.size() || (old_index < _elements.size() && !_compare(batch[batch_index], _elements[old_index])))
+					{
+						// Skip a batch element that already exists in the container.
+						if (batch_index < batch.size() && _equivalent(_elements[old_index], batch[batch_index]))
+							++batch_index;
+
+						if (prime_index < _elements_prime_order.size() && _elements_prime_order[prime_index] == old_index)
+						{
+							merged_prime_order.push_back(static_cast<index_type>(merged.size()));
+							++prime_index;
+						}
+
+						for (size_t view = 0; view < _views.size(); ++view)
+						{
+							if (view_index[view] < _views[view].order.size() && _views[view].order[view_index[view]] == old_index)
+							{
+								merged_views[view].push_back(static_cast<index_type>(merged.size()));
+								++view_index[view];
+							}
+						}
+
+						merged.push_back(_elements[old_index++]);
+					}
+
+					else
+					{
+						if (_prime_order_built.ready() && is_prime(batch_index))
+							merged_prime_order.push_back(static_cast<index_type>(merged.size()));
+
+						for (size_t view = 0; view < _views.size(); ++view)
+						{
+							if (_views[view].built.ready() && _views[view].predicate(batch[batch_index]))
+								merged_views[view].push_back(static_cast<index_type>(merged.size()));
+						}
+
+						merged.push_back(batch[batch_index++]);
+					}
+				}
+
+				// Nothing is swapped in if the positions overflowed, so the container is left unchanged.
+				_checkSize(merged.size());
+
+				_elements.swap(merged);
+				_elements_prime_order.swap(merged_prime_order);
+
+				for (size_t view = 0; view < _views.size(); ++view)
+					_views[view].order.swap(merged_views[view]);
+			}
+
+			/*
+			 * @brief Remove a batch of elements from the container.
+			 * @param batch The elements to remove, in any order and possibly with duplicates.
+			 * @return The amount of elements removed.
+			 * @note Time complexity: O(k log k + n), where k is the batch size.
+			*/
+			size_t _removeBatch(std::vector<T> batch);
+
+			/*
+			 * @brief Remove every element that satisfies a predicate, compacting all the orders in a single pass.
+			 * @param predicate A callable that takes an element and returns true if it should be removed.
+			 			It is called exactly once per element, in ascending order.
+			 * @return The amount of elements removed.
+			 * @note The predicate is evaluated for every element before anything is moved, so if it throws
+			 			the container is left unchanged.
+			 * @note Time complexity: O(n).
+			*/
+			template <typename Predicate>
+			size_t _compact(Predicate predicate) {
+				std::vector<bool> removed_mask(_elements.size());
+				size_t removed = 0;
+
+				for (size_t read = 0; read < _elements.size(); ++read)
+				{
+					if (predicate(_elements[read]))
+					{
+						removed_mask[read] = true;
+						++removed;
+					}
+				}
+
+				if (removed == 0)
+					return 0;
+
+				size_t write = 0, prime_read = 0, prime_write = 0;
+				std::vector<size_t> view_read(_views.size(), 0), view_write(_views.size(), 0);
+
+				// Carry an order's entry for the element at read, if it has one, unless the element is removed.
+				auto carry = [&write](index_vector &order, size_t &order_read, size_t &order_write, size_t read, bool drop) {
+					if (order_read < order.size() && order[order_read] == read)
+					{
+						++order_read;
+
+						if (!drop)
+							order[order_write++] = static_cast<index_type>(write);
+					}
+				};
+
+				for (size_t read = 0; read < _elements.size(); ++read)
+				{
+					carry(_elements_prime_order, prime_read, prime_write, read, removed_mask[read]);
+
+					for (size_t view = 0; view < _views.size(); ++view)
+						carry(_views[view].order, view_read[view], view_write[view], read, removed_mask[read]);
+
+					if (!removed_mask[read])
+						_elements[write++] = _elements[read];
+				}
+
+				_elements.resize(write);
+				_elements_prime_order.resize(prime_write);
+
+				for (size_t view = 0; view < _views.size(); ++view)
+					_views[view].order.resize(view_write[view]);
+
+				return removed;
+			}
 
 		public:
 			/*
 			 * @brief Construct a new Magical Container object.
 			 * @note The container is empty by default.
 			*/
-			MagicalContainer() = default;
+			BasicMagicalContainer() = default;
+
+			/*
+			 * @brief Construct a new Magical Container object with a given ordering and allocator.
+			 * @param compare The ordering of the elements.
+			 * @param alloc The allocator for the element storage.
+			*/
+			explicit BasicMagicalContainer(const Compare &compare, const Alloc &alloc = Alloc()):
+				_elements(alloc), _elements_prime_order(alloc), _compare(compare) { }
+
+			/*
+			 * @brief Construct a new Magical Container object with a given allocator.
+			 * @param alloc The allocator for the element storage.
+			*/
+			explicit BasicMagicalContainer(const Alloc &alloc): BasicMagicalContainer(Compare(), alloc) { }
+
+			/*
+			 * @brief Returns the container's allocator.
+			 * @return A copy of the allocator of the element storage.
+			*/
+			allocator_type get_allocator() const {
+				return _elements.get_allocator();
+			}
 
 			/*
 			 * @brief Add an element to the container.
 			 * @param element The element to add.
 			 * @note If the element already exists in the container, it will not be added.
 			 * @note The element is added to the container's elements in ascending order.
-			 * @note Time complexity: O(n).
+			 * @note Time complexity: O(log n) to locate, O(n) to shift the storage.
+			*/
+			void addElement(T element);
+
+			/*
+			 * @brief Add a range of elements to the container.
+			 * @param first An iterator to the first element to add.
+			 * @param last An iterator past the last element to add.
+			 * @note Elements that already exist in the container (or repeat in the range) are added once.
+			 * @note Time complexity: O(k log k + n), where k is the amount of elements in the range.
+			*/
+			template <typename InputIt>
+			void addElements(InputIt first, InputIt last) {
+				_addBatch(std::vector<T>(first, last));
+			}
+
+			/*
+			 * @brief Add a list of elements to the container.
+			 * @param elements The elements to add.
+			 * @note Elements that already exist in the container (or repeat in the list) are added once.
+			 * @note Time complexity: O(k log k + n), where k is the amount of elements in the list.
 			*/
-			void addElement(int element);
+			void addElements(std::initializer_list<T> elements) {
+				addElements(elements.begin(), elements.end());
+			}
 
 			/*
 			 * @brief Remove an element from the container.
 			 * @param element The element to remove.
 			 * @throw std::runtime_error If the element does not exist in the container.
-			 * @note Time complexity: O(n).
+			 * @note Time complexity: O(log n) to locate, O(n) to shift the storage.
+			*/
+			void removeElement(T element);
+
+			/*
+			 * @brief Remove a range of elements from the container.
+			 * @param first An iterator to the first element to remove.
+			 * @param last An iterator past the last element to remove.
+			 * @return The amount of elements removed.
+			 * @note Unlike removeElement, elements that do not exist in the container are ignored.
+			 * @note Time complexity: O(k log k + n), where k is the amount of elements in the range.
+			*/
+			template <typename InputIt>
+			size_t removeElements(InputIt first, InputIt last) {
+				return _removeBatch(std::vector<T>(first, last));
+			}
+
+			/*
+			 * @brief Remove a list of elements from the container.
+			 * @param elements The elements to remove.
+			 * @return The amount of elements removed.
+			 * @note Unlike removeElement, elements that do not exist in the container are ignored.
+			 * @note Time complexity: O(k log k + n), where k is the amount of elements in the list.
+			*/
+			size_t removeElements(std::initializer_list<T> elements) {
+				return removeElements(elements.begin(), elements.end());
+			}
+
+			/*
+			 * @brief Remove all the elements in the value range [low, high).
+			 * @param low The smallest value to remove.
+			 * @param high The value after the biggest value to remove.
+			 * @return The amount of elements removed.
+			 * @note Time complexity: O(log n) to locate, O(n) to shift the storage.
 			*/
-			void removeElement(int element);
+			size_t removeRange(T low, T high);
+
+			/*
+			 * @brief Remove every element that satisfies a predicate.
+			 * @param predicate A callable that takes an element and returns true if it should be removed.
+			 * @return The amount of elements removed.
+			 * @note If the predicate throws, the exception propagates and the container is left unchanged.
+			 * @note Time complexity: O(n), all the orders are compacted in a single pass.
+			*/
+			template <typename Predicate>
+			size_t removeIf(Predicate predicate) {
+				return _compact([&predicate](const T &element) { return static_cast<bool>(predicate(element)); });
+			}
+
+			/*
+			 * @brief Get the k-th element in ascending order.
+			 * @param k The zero-based position of the element.
+			 * @return The k-th element in ascending order.
+			 * @throw std::runtime_error If k is not less than the size of the container.
+			 * @note Time complexity: O(1).
+			*/
+			T nthAscending(size_t k) const;
+
+			/*
+			 * @brief Get the k-th element in sidecross order.
+			 * @param k The zero-based position of the element.
+			 * @return The k-th element in sidecross order.
+			 * @throw std::runtime_error If k is not less than the size of the container.
+			 * @note Time complexity: O(1).
+			*/
+			T nthSideCross(size_t k) const;
+
+			/*
+			 * @brief Get the k-th prime element.
+			 * @param k The zero-based position of the element in prime order.
+			 * @return The k-th prime element.
+			 * @throw std::runtime_error If k is not less than the amount of prime elements.
+			 * @note Time complexity: O(1).
+			*/
+			T nthPrime(size_t k) const;
+
+			/*
+			 * @brief Get the rank of a value in ascending order.
+			 * @param value The value to rank, it does not have to exist in the container.
+			 * @return The amount of elements less than the value, which is the element's position if it exists.
+			 * @note Time complexity: O(log n).
+			*/
+			size_t rankOf(T value) const;
+
+			/*
+			 * @brief Get the rank of a value in prime order.
+			 * @param value The value to rank, it does not have to exist in the container.
+			 * @return The amount of prime elements less than the value, which is the element's position if it is a prime element.
+			 * @note Time complexity: O(log n).
+			*/
+			size_t primeRankOf(T value) const;
+
+			/*
+			 * @brief Get the position of an element in sidecross order.
+			 * @param element The element to rank.
+			 * @return The zero-based position of the element in sidecross order.
+			 * @throw std::runtime_error If the element does not exist in the container.
+			 * @note Time complexity: O(log n).
+			*/
+			size_t sideCrossRankOf(T element) const;
+
+			/*
+			 * @brief Register a named filtered view, maintained on every insertion and removal like the prime order once built.
+			 * @param name The name of the view.
+			 * @param predicate A callable that takes an element and returns true if it belongs to the view.
+			 			It must be deterministic and must not throw.
+			 * @return The id of the view, to be passed to FilteredIterator and the other view queries.
+			 * @throw std::runtime_error If a view with the same name already exists.
+			 * @note The view is built lazily, on its first use. Time complexity: O(v), where v is the amount of views.
+			 * @note Every built view adds O(1) per element to bulk operations, and a predicate call
+			 			plus an O(m) index shift to addElement and removeElement.
+			*/
+			size_t addView(std::string name, std::function<bool(const T &)> predicate);
+
+			/*
+			 * @brief Build the prime order and every filtered view that is not built yet.
+			 * @note The const member functions build a view on its first use. Concurrent readers are safe, as the build
+			 			is serialized, but the first reader pays for it. Call this first to keep the readers' latency flat.
+			 * @note Time complexity: O(n) per view that is not built yet.
+			*/
+			void materializeViews() const;
+
+			/*
+			 * @brief Get the id of a filtered view by its name.
+			 * @param name The name of the view.
+			 * @return The id of the view.
+			 * @throw std::runtime_error If there is no view with that name.
+			 * @note Time complexity: O(v), where v is the amount of views.
+			*/
+			size_t viewId(const std::string &name) const;
+
+			/*
+			 * @brief Return the amount of elements in a filtered view.
+			 * @param view The id of the view.
+			 * @return The amount of elements in the view.
+			 * @throw std::runtime_error If there is no view with that id.
+			 * @note Time complexity: O(1).
+			*/
+			size_t viewSize(size_t view) const;
+
+			/*
+			 * @brief Get the k-th element of a filtered view.
+			 * @param view The id of the view.
+			 * @param k The zero-based position of the element in the view.
+			 * @return The k-th element of the view, in ascending order.
+			 * @throw std::runtime_error If there is no view with that id, or k is not less than its size.
+			 * @note Time complexity: O(1).
+			*/
+			T nthInView(size_t view, size_t k) const;
+
+			/*
+			 * @brief Save the container to a binary snapshot file (see FileHeader for the layout).
+			 * @param path The path of the file, replaced if it exists.
+			 * @throw std::runtime_error If the file cannot be written. The existing file is left unchanged in that case.
+			 * @note The snapshot is written to path + ".tmp" and then renamed over the path, so the replacement is
+			 			atomic and a container still mapping the old file keeps reading the old contents.
+			 * @note The prime order is saved along with the elements, and built first if it is not built yet.
+			 			The filtered views are not saved, as their predicates are code.
+			 * @note The ordering is recorded in the file, so it can only be read back with the same one.
+			 * @note Time complexity: O(n), a bulk write of the storage.
+			*/
+			void save(const std::string &path) const;
+
+			/*
+			 * @brief Replace the container's elements with the ones in a binary snapshot file.
+			 * @param path The path of the file, written by save() from a container with the same element type and ordering.
+			 * @throw std::runtime_error If the file cannot be read, is not a valid snapshot, holds a different element type,
+			 			or was saved with a different ordering. The container is left unchanged in that case.
+			 * @note The elements and the prime order are bulk copied, nothing is re-sorted or re-tested for primality.
+			 			The filtered views are kept registered, and rebuilt on their next use.
+			 * @note Time complexity: O(n), a bulk read and a linear validation pass over the elements.
+			*/
+			void load(const std::string &path);
+
+			/*
+			 * @brief Return the amount of prime elements in the container.
+			 * @return The amount of prime elements in the container.
+			 * @note Time complexity: O(1).
+			*/
+			size_t primeCount() const {
+				return _primeOrder().size();
+			}
 
 			/*
 			 * @brief Return the size of the container.
@@ -106,518 +738,427 @@ namespace ariel
 		/*
 		 * @brief An iterator that iterates over the container's elements in ascending order.
 		*/
-		class AscendingIterator: public IIterator
+		template <bool Checked>
+		class BasicAscendingIterator: public BasicIndexIterator<BasicAscendingIterator<Checked>, BasicMagicalContainer, T, Checked>
 		{
 			private:
-				/*
-				 * @brief The container to iterate over.
-				 * @note This is a reference to the container, so it must not be destroyed while the iterator is in use.
-				*/
-				const MagicalContainer *_container;
+				using Base = BasicIndexIterator<BasicAscendingIterator<Checked>, BasicMagicalContainer, T, Checked>;
 
-				/*
-				 * @brief The current index of the iterator.
-				 * @note The index is valid if it is less than the size of the container.
-				*/
-				size_t _index;
+				friend Base;
+				friend class BasicMagicalContainer;
 
 				/*
 				 * @brief Construct a new Ascending Iterator object.
 				 * @param container The container to iterate over.
 				 * @param index The index to start iterating from.
-				 * @note The iterator is initialized to the element at the given index in the container.
+				 * @note The iterator is initialized to the element at the given index in the order.
+				*/
+				BasicAscendingIterator(const BasicMagicalContainer *container, size_t index): Base(container, index) { }
+
+				/*
+				 * @brief Returns the index of the end() iterator.
+				 * @return The amount of elements in the iterated order.
 				*/
-				AscendingIterator(const MagicalContainer *container, size_t index): _container(container), _index(index) { }
+				size_t _limit() const {
+					return this->_container->_elements.size();
+				}
 
 			public:
 				/*
 				 * @brief Construct a new Ascending Iterator object, uninitialized (points to no container).
 				 * @note This iterator is not dereferenceable, and must be assigned to a valid iterator before use.
 				*/
-				AscendingIterator(): _container(nullptr), _index(0) { }
+				BasicAscendingIterator() = default;
 
 				/*
 				 * @brief Construct a new Ascending Iterator object.
 				 * @param container The container to iterate over.
 				 * @note The iterator is initialized to the first element in the container.
 				*/
-				AscendingIterator(const MagicalContainer &container): AscendingIterator(&container, 0) { }
+				BasicAscendingIterator(const BasicMagicalContainer &container): BasicAscendingIterator(&container, 0) { }
 
 				/*
-				 * @brief Destroy the Ascending Iterator object.
-				 * @note Use the default destructor, as the container property is a vector, which has its own destructor.
-				*/
-				~AscendingIterator() override = default;
-
-				/*
-				 * @brief Copy constructor.
-				 * @param other The iterator to copy.
-				*/
-				AscendingIterator(const AscendingIterator &other);
-
-				/*
-				 * @brief Move constructor.
-				 * @param other The iterator to move.
-				 * @note The other iterator is left in a valid but unspecified state.
-				 * @note Use the default move constructor, as the container property is a vector, which has its own move constructor.
-				*/
-				AscendingIterator(AscendingIterator &&other) noexcept;
-				
-				/*
-				 * @brief Copy assignment operator.
-				 * @param other The iterator to copy.
-				 * @return A reference to this iterator.
-				*/
-				AscendingIterator &operator=(const AscendingIterator &other);
-
-				/*
-				 * @brief Move assignment operator.
-				 * @param other The iterator to move.
-				 * @return A reference to this iterator.
-				 * @note The other iterator is left in a valid but unspecified state.
-				 * @note Use the default move assignment operator, as the container property is a vector, which has its own move assignment operator.
-				*/
-				AscendingIterator &operator=(AscendingIterator &&other) noexcept;
-			
-				/*
-				 * @brief Equality operator, checks if two iterators are equal by comparing their index.
-				 * @param other The iterator to compare to.
-				 * @return True if the iterators are equal, false otherwise.
-				 * @throw std::runtime_error If the iterators are from different containers or different types.
-				*/
-				bool operator==(const IIterator &other) const override;
-
-				/*
-				 * @brief Inequality operator, checks if two iterators are not equal by comparing their index.
-				 * @param other The iterator to compare to.
-				 * @return True if the iterators are not equal, false otherwise.
-				 * @throw std::runtime_error If the iterators are from different containers or different types.
+				 * @brief Dereference operator, returns the element at the current index.
+				 * @return The element at the current index.
+				 * @throw std::runtime_error If checked, and the iterator is not initialized or out of range.
 				*/
-				bool operator!=(const IIterator &other) const override;
+				const T &operator*() const noexcept(!Checked) {
+					this->_checkDereferenceable();
+					return this->_container->_elements[this->_index];
+				}
+		};
 
-				/*
-				 * @brief Less than operator, checks if this iterator is less than the other iterator by comparing their index.
-				 * @param other The iterator to compare to.
-				 * @return True if this iterator is less than the other iterator, false otherwise.
-				 * @throw std::runtime_error If the iterators are from different containers or different types.
-				*/
-				bool operator<(const IIterator &other) const override;
+		/*
+		 * @brief A class representing an iterator over the elements of the container in sidecross order.
+		*/
+		template <bool Checked>
+		class BasicSideCrossIterator: public BasicIndexIterator<BasicSideCrossIterator<Checked>, BasicMagicalContainer, T, Checked>
+		{
+			private:
+				using Base = BasicIndexIterator<BasicSideCrossIterator<Checked>, BasicMagicalContainer, T, Checked>;
 
-				/*
-				 * @brief Greater than operator, checks if this iterator is greater than the other iterator by comparing their index.
-				 * @param other The iterator to compare to.
-				 * @return True if this iterator is greater than the other iterator, false otherwise.
-				 * @throw std::runtime_error If the iterators are from different containers or different types.
-				*/
-				bool operator>(const IIterator &other) const override;
+				friend Base;
+				friend class BasicMagicalContainer;
 
 				/*
-				 * @brief Equality operator, checks if two iterators are equal by comparing their index.
-				 * @param other The iterator to compare to.
-				 * @return True if the iterators are equal, false otherwise.
-				 * @throw std::runtime_error If the iterators are from different containers.
+				 * @brief Construct a new Side Cross Iterator object.
+				 * @param container The container to iterate over.
+				 * @param index The index to start iterating from.
+				 * @note The iterator is initialized to the element at the given index in the order.
 				*/
-				bool operator==(const AscendingIterator &other) const;
+				BasicSideCrossIterator(const BasicMagicalContainer *container, size_t index): Base(container, index) { }
 
 				/*
-				 * @brief Inequality operator, checks if two iterators are not equal by comparing their index.
-				 * @param other The iterator to compare to.
-				 * @return True if the iterators are not equal, false otherwise.
+				 * @brief Returns the index of the end() iterator.
+				 * @return The amount of elements in the iterated order.
 				*/
-				bool operator!=(const AscendingIterator &other) const;
+				size_t _limit() const {
+					return this->_container->_elements.size();
+				}
 
+			public:
 				/*
-				 * @brief Less than operator, checks if this iterator is less than the other iterator by comparing their index.
-				 * @param other The iterator to compare to.
-				 * @return True if this iterator is less than the other iterator, false otherwise.
+				 * @brief Construct a new Side Cross Iterator object, uninitialized (points to no container).
+				 * @note This iterator is not dereferenceable, and must be assigned to a valid iterator before use.
 				*/
-				bool operator<(const AscendingIterator &other) const;
+				BasicSideCrossIterator() = default;
 
 				/*
-				 * @brief Greater than operator, checks if this iterator is greater than the other iterator by comparing their index.
-				 * @param other The iterator to compare to.
-				 * @return True if this iterator is greater than the other iterator, false otherwise.
+				 * @brief Construct a new Side Cross Iterator object.
+				 * @param container The container to iterate over.
+				 * @note The iterator is initialized to the first element in the container.
 				*/
-				bool operator>(const AscendingIterator &other) const;
+				BasicSideCrossIterator(const BasicMagicalContainer &container): BasicSideCrossIterator(&container, 0) { }
 
 				/*
 				 * @brief Dereference operator, returns the element at the current index.
 				 * @return The element at the current index.
-				 * @throw std::runtime_error If the iterator is out of range.
+				 * @throw std::runtime_error If checked, and the iterator is not initialized or out of range.
 				*/
-				int operator*() const;
-
-				/*
-				 * @brief Prefix increment operator, increments the iterator to the next element.
-				 * @return A reference to this iterator.
-				 * @throw std::runtime_error If the iterator is out of range.
-				*/
-				AscendingIterator &operator++();
-
-				/*
-				 * @brief Returns an iterator to the first element in the container.
-				 * @return An iterator to the first element in the container.
-				 * @note If the container is empty, the iterator returned is equal to the iterator returned by end().
-				*/
-				AscendingIterator begin() {
-					return AscendingIterator(_container, 0);
-				}
-
-				/*
-				 * @brief Returns an iterator to the element after the last element in the container.
-				 * @return An iterator to the element after the last element in the container.
-				 * @note This iterator is not dereferenceable.
-				*/
-				AscendingIterator end() const {
-					return AscendingIterator(_container, _container->_elements_ascending_order.size());
+				const T &operator*() const noexcept(!Checked) {
+					this->_checkDereferenceable();
+					return this->_container->_elements[sideCrossToAscending(this->_index, this->_container->_elements.size())];
 				}
 		};
 
 		/*
-		 * @brief A class representing an iterator over the elements of the container in sidecross order.
+		 * @brief An iterator over the elements in the container, but only the prime ones.
 		*/
-		class SideCrossIterator: public IIterator
+		template <bool Checked>
+		class BasicPrimeIterator: public BasicIndexIterator<BasicPrimeIterator<Checked>, BasicMagicalContainer, T, Checked>
 		{
 			private:
-				/*
-				 * @brief The container to iterate over.
-				 * @note This is a reference to the container, so it must not be destroyed while the iterator is in use.
-				*/
-				const MagicalContainer *_container;
+				using Base = BasicIndexIterator<BasicPrimeIterator<Checked>, BasicMagicalContainer, T, Checked>;
+
+				friend Base;
+				friend class BasicMagicalContainer;
 
 				/*
-				 * @brief The current index of the iterator.
-				 * @note The index is valid if it is less than the size of the container.
+				 * @brief Construct a new Prime Iterator object.
+				 * @param container The container to iterate over.
+				 * @param index The index to start iterating from.
+				 * @note The iterator is initialized to the element at the given index in the order.
 				*/
-				size_t _index;
+				BasicPrimeIterator(const BasicMagicalContainer *container, size_t index): Base(container, index) { }
 
 				/*
-				 * @brief Construct a new Side Cross Iterator object, with a given index.
-				 * @param container The container to iterate over.
-				 * @param index The index to initialize the iterator to.
-				 * @note The iterator is initialized to the given index.
+				 * @brief Returns the index of the end() iterator.
+				 * @return The amount of elements in the iterated order.
 				*/
-				SideCrossIterator(const MagicalContainer *container, size_t index): _container(container), _index(index) {}
+				size_t _limit() const {
+					return this->_container->_elements_prime_order.size();
+				}
 
 			public:
 				/*
-				 * @brief Construct a new Side Cross Iterator object, uninitialized (points to no container).
+				 * @brief Construct a new Prime Iterator object, uninitialized (points to no container).
 				 * @note This iterator is not dereferenceable, and must be assigned to a valid iterator before use.
 				*/
-				SideCrossIterator(): _container(nullptr), _index(0) {}
+				BasicPrimeIterator() = default;
 
 				/*
-				 * @brief Construct a new Side Cross Iterator object.
-				 * @param cont The container to iterate over.
+				 * @brief Construct a new Prime Iterator object.
+				 * @param container The container to iterate over.
 				 * @note The iterator is initialized to the first element in the container.
+				 * @note Builds the prime order, if this is its first use.
 				*/
-				SideCrossIterator(const MagicalContainer &container): _container(&container), _index(0) {}
-
-				/*
-				 * @brief Destroy the Side Cross Iterator object.
-				 * @note Use the default destructor, as the container property is a vector, which has its own destructor.
-				*/
-				~SideCrossIterator() override = default;
-
-				/*
-				 * @brief Copy constructor.
-				 * @param other The iterator to copy.
-				*/
-				SideCrossIterator(const SideCrossIterator &other);
+				BasicPrimeIterator(const BasicMagicalContainer &container): BasicPrimeIterator(&container, 0) {
+					container._primeOrder();
+				}
 
 				/*
-				 * @brief Move constructor.
-				 * @param other The iterator to move.
-				 * @note The other iterator is left in a valid but unspecified state.
-				 * @note Use the default move constructor, as the container property is a vector, which has its own move constructor.
-				*/
-				SideCrossIterator(SideCrossIterator &&other) noexcept;
-				
-				/*
-				 * @brief Copy assignment operator.
-				 * @param other The iterator to copy.
-				 * @return A reference to this iterator.
+				 * @brief Dereference operator, returns the element at the current index.
+				 * @return The element at the current index.
+				 * @throw std::runtime_error If checked, and the iterator is not initialized or out of range.
 				*/
-				SideCrossIterator &operator=(const SideCrossIterator &other);
+				const T &operator*() const noexcept(!Checked) {
+					this->_checkDereferenceable();
+					return this->_container->_elements[this->_container->_elements_prime_order[this->_index]];
+				}
+		};
 
-				/*
-				 * @brief Move assignment operator.
-				 * @param other The iterator to move.
-				 * @return A reference to this iterator.
-				 * @note The other iterator is left in a valid but unspecified state.
-				 * @note Use the default move assignment operator, as the container property is a vector, which has its own move assignment operator.
-				*/
-				SideCrossIterator &operator=(SideCrossIterator &&other) noexcept;
-			
-				/*
-				 * @brief Equality operator, checks if two iterators are equal by comparing their index.
-				 * @param other The iterator to compare to.
-				 * @return True if the iterators are equal, false otherwise.
-				 * @throw std::runtime_error If the iterators are from different containers or different types.
-				*/
-				bool operator==(const IIterator &other) const override;
+		/*
+		 * @brief An iterator over the elements of a registered filtered view, in ascending order.
+		 * @note Checked iterators over different views of the same container throw when compared.
+		*/
+		template <bool Checked>
+		class BasicFilteredIterator: public BasicIndexIterator<BasicFilteredIterator<Checked>, BasicMagicalContainer, T, Checked>
+		{
+			private:
+				using Base = BasicIndexIterator<BasicFilteredIterator<Checked>, BasicMagicalContainer, T, Checked>;
 
-				/*
-				 * @brief Inequality operator, checks if two iterators are not equal by comparing their index.
-				 * @param other The iterator to compare to.
-				 * @return True if the iterators are not equal, false otherwise.
-				 * @throw std::runtime_error If the iterators are from different containers or different types.
-				*/
-				bool operator!=(const IIterator &other) const override;
+				friend Base;
+				friend class BasicMagicalContainer;
 
 				/*
-				 * @brief Less than operator, checks if this iterator is less than the other iterator by comparing their index.
-				 * @param other The iterator to compare to.
-				 * @return True if this iterator is less than the other iterator, false otherwise.
-				 * @throw std::runtime_error If the iterators are from different containers or different types.
+				 * @brief The id of the iterated view.
 				*/
-				bool operator<(const IIterator &other) const override;
+				size_t _view;
 
 				/*
-				 * @brief Greater than operator, checks if this iterator is greater than the other iterator by comparing their index.
-				 * @param other The iterator to compare to.
-				 * @return True if this iterator is greater than the other iterator, false otherwise.
-				 * @throw std::runtime_error If the iterators are from different containers or different types.
+				 * @brief Returns the index of the end() iterator.
+				 * @return The amount of elements in the iterated view.
 				*/
-				bool operator>(const IIterator &other) const override;
+				size_t _limit() const {
+					return this->_container->_views[_view].order.size();
+				}
 
 				/*
-				 * @brief Equality operator, checks if two iterators are equal by comparing their index.
-				 * @param other The iterator to compare to.
-				 * @return True if the iterators are equal, false otherwise.
-				 * @throw std::runtime_error If the iterators are from different containers.
+				 * @brief Check if another iterator walks the same view as this one.
+				 * @param other The other iterator, over the same container.
+				 * @return True if both iterators walk the same view.
 				*/
-				bool operator==(const SideCrossIterator &other) const;
+				bool _sameOrder(const BasicFilteredIterator &other) const noexcept {
+					return _view == other._view;
+				}
 
+			public:
 				/*
-				 * @brief Inequality operator, checks if two iterators are not equal by comparing their index.
-				 * @param other The iterator to compare to.
-				 * @return True if the iterators are not equal, false otherwise.
-				 * @throw std::runtime_error If the iterators are from different containers.
+				 * @brief Construct a new Filtered Iterator object, uninitialized (points to no container).
+				 * @note This iterator is not dereferenceable, and must be assigned to a valid iterator before use.
 				*/
-				bool operator!=(const SideCrossIterator &other) const;
+				BasicFilteredIterator(): _view(0) { }
 
 				/*
-				 * @brief Less than operator, checks if this iterator is less than the other iterator by comparing their index.
-				 * @param other The iterator to compare to.
-				 * @return True if this iterator is less than the other iterator, false otherwise.
-				 * @throw std::runtime_error If the iterators are from different containers.
+				 * @brief Construct a new Filtered Iterator object.
+				 * @param container The container to iterate over.
+				 * @param view The id of the view to iterate over, as returned by addView.
+				 * @throw std::runtime_error If there is no view with that id.
+				 * @note The iterator is initialized to the first element in the view.
+				 * @note Builds the view, if this is its first use.
 				*/
-				bool operator<(const SideCrossIterator &other) const;
+				BasicFilteredIterator(const BasicMagicalContainer &container, size_t view): Base(&container, 0), _view(view) {
+					container._viewOrder(view);
+				}
 
 				/*
-				 * @brief Greater than operator, checks if this iterator is greater than the other iterator by comparing their index.
-				 * @param other The iterator to compare to.
-				 * @return True if this iterator is greater than the other iterator, false otherwise.
-				 * @throw std::runtime_error If the iterators are from different containers.
+				 * @brief Construct a new Filtered Iterator object.
+				 * @param container The container to iterate over.
+				 * @param name The name of the view to iterate over.
+				 * @throw std::runtime_error If there is no view with that name.
+				 * @note The iterator is initialized to the first element in the view.
 				*/
-				bool operator>(const SideCrossIterator &other) const;
+				BasicFilteredIterator(const BasicMagicalContainer &container, const std::string &name): BasicFilteredIterator(container, container.viewId(name)) { }
 
 				/*
 				 * @brief Dereference operator, returns the element at the current index.
 				 * @return The element at the current index.
-				 * @throw std::runtime_error If the iterator is out of range.
-				*/
-				int operator*() const;
-
-				/*
-				 * @brief Prefix increment operator, increments the iterator to the next element.
-				 * @return A reference to this iterator.
-				 * @throw std::runtime_error If the iterator is out of range.
+				 * @throw std::runtime_error If checked, and the iterator is not initialized or out of range.
 				*/
-				SideCrossIterator &operator++();
-
-				/*
-				 * @brief Returns an iterator to the first element in the container.
-				 * @return An iterator to the first element in the container.
-				 * @note If the container is empty, the iterator returned is equal to the iterator returned by end().
-				*/
-				SideCrossIterator begin() {
-					return SideCrossIterator(_container, 0);
-				}
-
-				/*
-				 * @brief Returns an iterator to the element after the last element in the container.
-				 * @return An iterator to the element after the last element in the container.
-				 * @note This iterator is not dereferenceable.
-				*/
-				SideCrossIterator end() const {
-					return SideCrossIterator(_container, _container->_elements_sidecross_order.size());
+				const T &operator*() const noexcept(!Checked) {
+					this->_checkDereferenceable();
+					return this->_container->_elements[this->_container->_views[_view].order[this->_index]];
 				}
 		};
 
 		/*
-		 * @brief An iterator over the elements in the container, but only the prime ones.
+		 * @brief The default iterators, checked unless built as a release build (see CHECKED_ITERATORS).
+		 * @note Nothing compiled into MagicalContainer.o takes or returns these aliases, as their meaning depends
+		 			on the including translation unit's NDEBUG. The finders are templates on Checked instead.
 		*/
-		class PrimeIterator: public IIterator
-		{
-			private:
-				/*
-				 * @brief The container to iterate over.
-				 * @note This is a reference to the container, so it must not be destroyed while the iterator is in use.
-				*/
-				const MagicalContainer *_container;
+		using AscendingIterator = BasicAscendingIterator<CHECKED_ITERATORS>;
+		using SideCrossIterator = BasicSideCrossIterator<CHECKED_ITERATORS>;
+		using PrimeIterator = BasicPrimeIterator<CHECKED_ITERATORS>;
+		using FilteredIterator = BasicFilteredIterator<CHECKED_ITERATORS>;
 
-				/*
-				 * @brief The current index of the iterator.
-				 * @note The index is valid if it is less than the size of the container.
-				*/
-				size_t _index;
-
-				/*
-				 * @brief Construct a new Prime Iterator object, with a given index.
-				 * @param container The container to iterate over.
-				 * @param index The index to initialize the iterator to.
-				 * @note The iterator is initialized to the given index.
-				*/
-				PrimeIterator(const MagicalContainer *container, size_t index): _container(container), _index(index) {}
+		/*
+		 * @brief Iterators that never validate their state, for hot loops over known-valid ranges.
+		*/
+		using UncheckedAscendingIterator = BasicAscendingIterator<false>;
+		using UncheckedSideCrossIterator = BasicSideCrossIterator<false>;
+		using UncheckedPrimeIterator = BasicPrimeIterator<false>;
+		using UncheckedFilteredIterator = BasicFilteredIterator<false>;
 
-			public:
+			/*
+			 * @brief Check if an element exists in the container.
+			 * @param element The element to look for.
+			 * @return True if the element exists in the container, false otherwise.
+			 * @note Time complexity: O(log n).
+			*/
+			bool contains(T element) const;
 
-				/*
-				 * @brief Construct a new Prime Iterator object, uninitialized (points to no container).
-				 * @note This iterator is not dereferenceable, and must be assigned to a valid iterator before use.
-				*/
-				PrimeIterator(): _container(nullptr), _index(0) {}
+			/*
+			 * @brief Find an element in ascending order.
+			 * @tparam Checked Whether the returned iterator is checked, CHECKED_ITERATORS by default.
+			 * @param element The element to find.
+			 * @return An iterator positioned at the element, or the end() iterator if the element does not exist.
+			 * @note Time complexity: O(log n).
+			*/
+			template <bool Checked = CHECKED_ITERATORS>
+			BasicAscendingIterator<Checked> findAscending(T element) const {
+				return BasicAscendingIterator<Checked>(this, _indexOf(element));
+			}
 
-				/*
-				 * @brief Construct a new Prime Iterator object.
-				 * @param container The container to iterate over.
-				 * @note The iterator is initialized to the first element in the container.
-				*/
-				PrimeIterator(const MagicalContainer &container): _container(&container), _index(0) {}
+			/*
+			 * @brief Find an element in sidecross order.
+			 * @tparam Checked Whether the returned iterator is checked, CHECKED_ITERATORS by default.
+			 * @param element The element to find.
+			 * @return An iterator positioned at the element, or the end() iterator if the element does not exist.
+			 * @note Time complexity: O(log n).
+			*/
+			template <bool Checked = CHECKED_ITERATORS>
+			BasicSideCrossIterator<Checked> findSideCross(T element) const {
+				size_t index = _indexOf(element);
 
-				/*
-				 * @brief Destroy the Prime Iterator object.
-				 * @note Use the default destructor, as the container property is a vector, which has its own destructor.
-				*/
-				~PrimeIterator() override = default;
+				if (index == _elements.size())
+					return BasicSideCrossIterator<Checked>(this, index);
 
-				/*
-				 * @brief Copy constructor.
-				 * @param other The iterator to copy.
-				*/
-				PrimeIterator(const PrimeIterator &other);
+				return BasicSideCrossIterator<Checked>(this, ascendingToSideCross(index, _elements.size()));
+			}
 
-				/*
-				 * @brief Move constructor.
-				 * @param other The iterator to move.
-				 * @note The other iterator is left in a valid but unspecified state.
-				 * @note Use the default move constructor, as the container property is a vector, which has its own move constructor.
-				*/
-				PrimeIterator(PrimeIterator &&other) noexcept;
-				
-				/*
-				 * @brief Copy assignment operator.
-				 * @param other The iterator to copy.
-				 * @return A reference to this iterator.
-				*/
-				PrimeIterator &operator=(const PrimeIterator &other);
+			/*
+			 * @brief Find an element in prime order.
+			 * @tparam Checked Whether the returned iterator is checked, CHECKED_ITERATORS by default.
+			 * @param element The element to find.
+			 * @return An iterator positioned at the element, or the end() iterator if the element does not exist or is not prime.
+			 * @note Time complexity: O(log n).
+			*/
+			template <bool Checked = CHECKED_ITERATORS>
+			BasicPrimeIterator<Checked> findPrime(T element) const {
+				size_t position = _lowerPrimeIndex(element);
 
-				/*
-				 * @brief Move assignment operator.
-				 * @param other The iterator to move.
-				 * @return A reference to this iterator.
-				 * @note The other iterator is left in a valid but unspecified state.
-				 * @note Use the default move assignment operator, as the container property is a vector, which has its own move assignment operator.
-				*/
-				PrimeIterator &operator=(PrimeIterator &&other) noexcept;
-			
-				/*
-				 * @brief Equality operator, checks if two iterators are equal by comparing their index.
-				 * @param other The iterator to compare to.
-				 * @return True if the iterators are equal, false otherwise.
-				 * @throw std::runtime_error If the iterators are from different containers or different types.
-				*/
-				bool operator==(const IIterator &other) const override;
+				if (position == _elements_prime_order.size() || !_equivalent(_elements[_elements_prime_order[position]], element))
+					return BasicPrimeIterator<Checked>(this, _elements_prime_order.size());
 
-				/*
-				 * @brief Inequality operator, checks if two iterators are not equal by comparing their index.
-				 * @param other The iterator to compare to.
-				 * @return True if the iterators are not equal, false otherwise.
-				 * @throw std::runtime_error If the iterators are from different containers or different types.
-				*/
-				bool operator!=(const IIterator &other) const override;
+				return BasicPrimeIterator<Checked>(this, position);
+			}
 
-				/*
-				 * @brief Less than operator, checks if this iterator is less than the other iterator by comparing their index.
-				 * @param other The iterator to compare to.
-				 * @return True if this iterator is less than the other iterator, false otherwise.
-				 * @throw std::runtime_error If the iterators are from different containers or different types.
-				*/
-				bool operator<(const IIterator &other) const override;
+			/*
+			 * @brief Find the first element in ascending order that is not less than a given value.
+			 * @tparam Checked Whether the returned iterator is checked, CHECKED_ITERATORS by default.
+			 * @param value The value to compare to.
+			 * @return An iterator positioned at the element, or the end() iterator if there is none.
+			 * @note Time complexity: O(log n).
+			*/
+			template <bool Checked = CHECKED_ITERATORS>
+			BasicAscendingIterator<Checked> lowerBoundAscending(T value) const {
+				return BasicAscendingIterator<Checked>(this, _lowerIndex(value));
+			}
 
-				/*
-				 * @brief Greater than operator, checks if this iterator is greater than the other iterator by comparing their index.
-				 * @param other The iterator to compare to.
-				 * @return True if this iterator is greater than the other iterator, false otherwise.
-				 * @throw std::runtime_error If the iterators are from different containers or different types.
-				*/
-				bool operator>(const IIterator &other) const override;
+			/*
+			 * @brief Find the first element in ascending order that is greater than a given value.
+			 * @tparam Checked Whether the returned iterator is checked, CHECKED_ITERATORS by default.
+			 * @param value The value to compare to.
+			 * @return An iterator positioned at the element, or the end() iterator if there is none.
+			 * @note Time complexity: O(log n).
+			*/
+			template <bool Checked = CHECKED_ITERATORS>
+			BasicAscendingIterator<Checked> upperBoundAscending(T value) const {
+				return BasicAscendingIterator<Checked>(this, _upperIndex(value));
+			}
 
-				/*
-				 * @brief Equality operator, checks if two iterators are equal by comparing their index.
-				 * @param other The iterator to compare to.
-				 * @return True if the iterators are equal, false otherwise.
-				 * @throw std::runtime_error If the iterators are from different containers.
-				*/
-				bool operator==(const PrimeIterator &other) const;
+			/*
+			 * @brief Find the first prime element that is not less than a given value.
+			 * @tparam Checked Whether the returned iterator is checked, CHECKED_ITERATORS by default.
+			 * @param value The value to compare to.
+			 * @return An iterator positioned at the element, or the end() iterator if there is none.
+			 * @note Time complexity: O(log n).
+			*/
+			template <bool Checked = CHECKED_ITERATORS>
+			BasicPrimeIterator<Checked> lowerBoundPrime(T value) const {
+				return BasicPrimeIterator<Checked>(this, _lowerPrimeIndex(value));
+			}
 
-				/*
-				 * @brief Inequality operator, checks if two iterators are not equal by comparing their index.
-				 * @param other The iterator to compare to.
-				 * @return True if the iterators are not equal, false otherwise.
-				 * @throw std::runtime_error If the iterators are from different containers.
-				*/
-				bool operator!=(const PrimeIterator &other) const;
+			/*
+			 * @brief Find the first prime element that is greater than a given value.
+			 * @tparam Checked Whether the returned iterator is checked, CHECKED_ITERATORS by default.
+			 * @param value The value to compare to.
+			 * @return An iterator positioned at the element, or the end() iterator if there is none.
+			 * @note Time complexity: O(log n).
+			*/
+			template <bool Checked = CHECKED_ITERATORS>
+			BasicPrimeIterator<Checked> upperBoundPrime(T value) const {
+				return BasicPrimeIterator<Checked>(this, _upperPrimeIndex(value));
+			}
 
-				/*
-				 * @brief Less than operator, checks if this iterator is less than the other iterator by comparing their index.
-				 * @param other The iterator to compare to.
-				 * @return True if this iterator is less than the other iterator, false otherwise.
-				 * @throw std::runtime_error If the iterators are from different containers.
-				*/
-				bool operator<(const PrimeIterator &other) const;
+			/*
+			 * @brief Get the elements in the value range [low, high), in ascending order.
+			 * @tparam Checked Whether the returned iterators are checked, CHECKED_ITERATORS by default.
+			 * @param low The smallest value in the range.
+			 * @param high The value after the biggest value in the range.
+			 * @return A pair of iterators, the first positioned at the first element in the range and the second past the last one.
+			 * @note If low is not less than high, the range is empty.
+			 * @note Time complexity: O(log n).
+			*/
+			template <bool Checked = CHECKED_ITERATORS>
+			std::pair<BasicAscendingIterator<Checked>, BasicAscendingIterator<Checked>> ascendingRange(T low, T high) const {
+				size_t first = _lowerIndex(low);
+				size_t last = _compare(low, high) ? _lowerIndex(high) : first;
 
-				/*
-				 * @brief Greater than operator, checks if this iterator is greater than the other iterator by comparing their index.
-				 * @param other The iterator to compare to.
-				 * @return True if this iterator is greater than the other iterator, false otherwise.
-				 * @throw std::runtime_error If the iterators are from different containers.
-				*/
-				bool operator>(const PrimeIterator &other) const;
+				return {BasicAscendingIterator<Checked>(this, first), BasicAscendingIterator<Checked>(this, last)};
+			}
 
-				/*
-				 * @brief Dereference operator, returns the element at the current index.
-				 * @return The element at the current index.
-				 * @throw std::runtime_error If the iterator is out of range.
-				*/
-				int operator*() const;
+			/*
+			 * @brief Get the prime elements in the value range [low, high), in ascending order.
+			 * @tparam Checked Whether the returned iterators are checked, CHECKED_ITERATORS by default.
+			 * @param low The smallest value in the range.
+			 * @param high The value after the biggest value in the range.
+			 * @return A pair of iterators, the first positioned at the first prime in the range and the second past the last one.
+			 * @note If low is not less than high, the range is empty.
+			 * @note Time complexity: O(log n).
+			*/
+			template <bool Checked = CHECKED_ITERATORS>
+			std::pair<BasicPrimeIterator<Checked>, BasicPrimeIterator<Checked>> primeRange(T low, T high) const {
+				size_t first = _lowerPrimeIndex(low);
+				size_t last = _compare(low, high) ? _lowerPrimeIndex(high) : first;
 
-				/*
-				 * @brief Prefix increment operator, increments the iterator to the next element.
-				 * @return A reference to this iterator.
-				 * @throw std::runtime_error If the iterator is out of range.
-				*/
-				PrimeIterator &operator++();
+				return {BasicPrimeIterator<Checked>(this, first), BasicPrimeIterator<Checked>(this, last)};
+			}
 
-				/*
-				 * @brief Returns an iterator to the first element in the container.
-				 * @return An iterator to the first element in the container.
-				 * @note If the container is empty, the iterator returned is equal to the iterator returned by end().
-				*/
-				PrimeIterator begin() {
-					return PrimeIterator(_container, 0);
-				}
+			/*
+			 * @brief Count the elements in the value range [low, high).
+			 * @param low The smallest value in the range.
+			 * @param high The value after the biggest value in the range.
+			 * @return The amount of elements in the range.
+			 * @note Time complexity: O(log n).
+			*/
+			size_t countInRange(T low, T high) const;
 
-				/*
-				 * @brief Returns an iterator to the element after the last element in the container.
-				 * @return An iterator to the element after the last element in the container.
-				 * @note This iterator is not dereferenceable.
-				*/
-				PrimeIterator end() const {
-					return PrimeIterator(_container, _container->_elements_prime_order.size());
-				}
-		};
+			/*
+			 * @brief Count the prime elements in the value range [low, high).
+			 * @param low The smallest value in the range.
+			 * @param high The value after the biggest value in the range.
+			 * @return The amount of prime elements in the range.
+			 * @note Time complexity: O(log n).
+			*/
+			size_t countPrimesInRange(T low, T high) const;
 	};
+
+	/*
+	 * @brief The container over int, with the default ordering and allocator.
+	*/
+	using MagicalContainer = BasicMagicalContainer<int>;
+
+	/*
+	 * @brief The container over int, allocating its storage and index vectors from a std::pmr::memory_resource.
+	 * @note Construct it with a memory resource, such as an Arena's, to keep the allocations off the global heap.
+	*/
+	using PmrMagicalContainer = BasicMagicalContainer<int, std::less<int>, std::pmr::polymorphic_allocator<int>>;
+
+	extern template class BasicMagicalContainer<int16_t>;
+	extern template class BasicMagicalContainer<int>;
+	extern template class BasicMagicalContainer<int, std::greater<int>>;
+	extern template class BasicMagicalContainer<int64_t>;
+	extern template class BasicMagicalContainer<uint64_t>;
+	extern template class BasicMagicalContainer<int, std::less<int>, std::pmr::polymorphic_allocator<int>>;
 }
\ No newline at end of file
@@ -0,0 +1,155 @@
+/*
+ *  Software Systems CPP Course Assignment 5
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "MappedMagicalContainer.hpp"
+#include "FileFormat.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace ariel;
+
+template <typename T, typename Compare>
+BasicMappedMagicalContainer<T, Compare>::BasicMappedMagicalContainer(const string &path):
+	_mapping(nullptr), _mapping_size(0), _elements(nullptr), _prime_order(nullptr), _count(0), _prime_count(0) {
+	int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+	if (fd < 0)
+		throw runtime_error("Cannot open file for reading");
+
+	struct stat info {};
+
+	if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(FileHeader))
+	{
+		close(fd);
+		throw runtime_error("Not a container snapshot file");
+	}
+
+	_mapping_size = static_cast<size_t>(info.st_size);
+	void *mapping = mmap(nullptr, _mapping_size, PROT_READ, MAP_SHARED, fd, 0);
+
+	// The mapping holds its own reference to the file.
+	close(fd);
+
+	if (mapping == MAP_FAILED)
+		throw runtime_error("Cannot map file");
+
+	_mapping = mapping;
+
+	const char *base = static_cast<const char *>(_mapping);
+	const FileHeader *header = reinterpret_cast<const FileHeader *>(base);
+
+	try
+	{
+		header->validate<T, Compare, index_type>(_mapping_size);
+	}
+
+	catch (...)
+	{
+		_unmap();
+		throw;
+	}
+
+	_count = static_cast<size_t>(header->count);
+	_prime_count = static_cast<size_t>(header->prime_count);
+	_elements = reinterpret_cast<const T *>(base + header->elements_offset);
+	_prime_order = reinterpret_cast<const index_type *>(base + header->primes_offset);
+}
+
+template <typename T, typename Compare>
+BasicMappedMagicalContainer<T, Compare>::~BasicMappedMagicalContainer() {
+	_unmap();
+}
+
+template <typename T, typename Compare>
+BasicMappedMagicalContainer<T, Compare>::BasicMappedMagicalContainer(BasicMappedMagicalContainer &&other) noexcept:
+	_mapping(exchange(other._mapping, nullptr)), _mapping_size(exchange(other._mapping_size, 0)),
+	_elements(exchange(other._elements, nullptr)), _prime_order(exchange(other._prime_order, nullptr)),
+	_count(exchange(other._count, 0)), _prime_count(exchange(other._prime_count, 0)) { }
+
+template <typename T, typename Compare>
+auto BasicMappedMagicalContainer<T, Compare>::operator=(BasicMappedMagicalContainer &&other) noexcept -> BasicMappedMagicalContainer & {
+	if (this != &other)
+	{
+		_unmap();
+
+		_mapping = exchange(other._mapping, nullptr);
+		_mapping_size = exchange(other._mapping_size, 0);
+		_elements = exchange(other._elements, nullptr);
+		_prime_order = exchange(other._prime_order, nullptr);
+		_count = exchange(other._count, 0);
+		_prime_count = exchange(other._prime_count, 0);
+	}
+
+	return *this;
+}
+
+template <typename T, typename Compare>
+void BasicMappedMagicalContainer<T, Compare>::_unmap() noexcept {
+	if (_mapping != nullptr)
+		munmap(_mapping, _mapping_size);
+
+	_mapping = nullptr;
+	_mapping_size = 0;
+	_elements = nullptr;
+	_prime_order = nullptr;
+	_count = 0;
+	_prime_count = 0;
+}
+
+template <typename T, typename Compare>
+bool BasicMappedMagicalContainer<T, Compare>::contains(T element) const {
+	return binary_search(_elements, _elements + _count, element, Compare());
+}
+
+template <typename T, typename Compare>
+T BasicMappedMagicalContainer<T, Compare>::nthAscending(size_t k) const {
+	if (k >= _count)
+		throw runtime_error("Index out of range");
+
+	return _elements[k];
+}
+
+template <typename T, typename Compare>
+T BasicMappedMagicalContainer<T, Compare>::nthSideCross(size_t k) const {
+	if (k >= _count)
+		throw runtime_error("Index out of range");
+
+	return _elements[sideCrossToAscending(k, _count)];
+}
+
+template <typename T, typename Compare>
+T BasicMappedMagicalContainer<T, Compare>::nthPrime(size_t k) const {
+	if (k >= _prime_count)
+		throw runtime_error("Index out of range");
+
+	return _elements[_prime_order[k]];
+}
+
+namespace ariel
+{
+	template class BasicMappedMagicalContainer<int16_t>;
+	template class BasicMappedMagicalContainer<int>;
+	template class BasicMappedMagicalContainer<int, std::greater<int>>;
+	template class BasicMappedMagicalContainer<int64_t>;
+	template class BasicMappedMagicalContainer<uint64_t>;
+}
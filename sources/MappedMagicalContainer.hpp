@@ -0,0 +1,308 @@
+/*
+ *  Software Systems CPP Course Assignment 5
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "IndexIterator.hpp"
+#include "MagicalContainer.hpp"
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace ariel
+{
+	/*
+	 * @brief A read-only container served straight from a memory-mapped snapshot file (see MagicalContainer::save).
+	 * @tparam T The element type, as saved in the file.
+	 * @tparam Compare The ordering the file was saved with.
+	 * @note Opening is O(1) regardless of the file size: only the header is validated, and the elements and
+	 			the prime order are read in place from the page cache, with no copy and no heap allocation.
+				Processes that map the same file share its pages.
+	 * @note The file is trusted beyond its header, and must not be modified while it is mapped.
+	 * @note The member functions are explicitly instantiated for int16_t, int, int64_t and uint64_t with the
+	 			default ordering, and for int with std::greater, matching BasicMagicalContainer's instantiations
+				(see IS_SUPPORTED_CONTAINER) except the allocator-aware one, whose files are mapped as int.
+	*/
+	template <typename T = int, typename Compare = std::less<T>>
+	class BasicMappedMagicalContainer
+	{
+		public:
+			using value_type = T;
+			using key_compare = Compare;
+			using index_type = typename BasicMagicalContainer<T, Compare>::index_type;
+
+		private:
+			/*
+			 * @brief The start of the mapping, or nullptr if nothing is mapped.
+			*/
+			void *_mapping;
+
+			/*
+			 * @brief The size of the mapping in bytes.
+			*/
+			size_t _mapping_size;
+
+			/*
+			 * @brief The mapped elements, sorted in ascending order.
+			*/
+			const T *_elements;
+
+			/*
+			 * @brief The mapped prime order, positions into _elements.
+			*/
+			const index_type *_prime_order;
+
+			/*
+			 * @brief The amount of elements.
+			*/
+			size_t _count;
+
+			/*
+			 * @brief The amount of prime elements.
+			*/
+			size_t _prime_count;
+
+			/*
+			 * @brief Unmap the file, if one is mapped.
+			*/
+			void _unmap() noexcept;
+
+		public:
+			/*
+			 * @brief Construct a new Mapped Magical Container object, mapping a snapshot file.
+			 * @param path The path of the file.
+			 * @throw std::runtime_error If the file cannot be opened or mapped, is not a valid snapshot,
+			 			holds a different element type, or was saved with a different ordering.
+			 * @note Time complexity: O(1).
+			*/
+			explicit BasicMappedMagicalContainer(const std::string &path);
+
+			/*
+			 * @brief Destroy the Mapped Magical Container object, unmapping the file.
+			 * @note No iterator over the container may be used afterwards.
+			*/
+			~BasicMappedMagicalContainer();
+
+			/*
+			 * @brief The container is movable but not copyable, as it owns its mapping.
+			 * @note A moved-from container is empty.
+			*/
+			BasicMappedMagicalContainer(const BasicMappedMagicalContainer &other) = delete;
+			BasicMappedMagicalContainer &operator=(const BasicMappedMagicalContainer &other) = delete;
+			BasicMappedMagicalContainer(BasicMappedMagicalContainer &&other) noexcept;
+			BasicMappedMagicalContainer &operator=(BasicMappedMagicalContainer &&other) noexcept;
+
+			/*
+			 * @brief Check if an element exists in the container.
+			 * @param element The element to look for.
+			 * @return True if the element exists in the container, false otherwise.
+			 * @note Time complexity: O(log n).
+			*/
+			bool contains(T element) const;
+
+			/*
+			 * @brief Get the k-th element in ascending order.
+			 * @param k The zero-based position of the element.
+			 * @return The k-th element in ascending order.
+			 * @throw std::runtime_error If k is not less than the size of the container.
+			*/
+			T nthAscending(size_t k) const;
+
+			/*
+			 * @brief Get the k-th element in sidecross order.
+			 * @param k The zero-based position of the element.
+			 * @return The k-th element in sidecross order.
+			 * @throw std::runtime_error If k is not less than the size of the container.
+			*/
+			T nthSideCross(size_t k) const;
+
+			/*
+			 * @brief Get the k-th prime element.
+			 * @param k The zero-based position of the element in prime order.
+			 * @return The k-th prime element.
+			 * @throw std::runtime_error If k is not less than the amount of prime elements.
+			*/
+			T nthPrime(size_t k) const;
+
+			/*
+			 * @brief Return the amount of prime elements in the container.
+			 * @return The amount of prime elements in the container.
+			*/
+			size_t primeCount() const {
+				return _prime_count;
+			}
+
+			/*
+			 * @brief Return the size of the container.
+			 * @return The size of the container.
+			*/
+			size_t size() const {
+				return _count;
+			}
+
+		/*
+		 * @brief An iterator over the mapped elements in ascending order.
+		*/
+		template <bool Checked>
+		class BasicAscendingIterator: public BasicIndexIterator<BasicAscendingIterator<Checked>, BasicMappedMagicalContainer, T, Checked>
+		{
+			private:
+				using Base = BasicIndexIterator<BasicAscendingIterator<Checked>, BasicMappedMagicalContainer, T, Checked>;
+
+				friend Base;
+
+				/*
+				 * @brief Returns the index of the end() iterator.
+				 * @return The amount of elements in the iterated order.
+				*/
+				size_t _limit() const {
+					return this->_container->_count;
+				}
+
+			public:
+				/*
+				 * @brief Construct a new Ascending Iterator object, uninitialized (points to no container).
+				*/
+				BasicAscendingIterator() = default;
+
+				/*
+				 * @brief Construct a new Ascending Iterator object, at the first element of the container.
+				 * @param container The container to iterate over.
+				*/
+				BasicAscendingIterator(const BasicMappedMagicalContainer &container): Base(&container, 0) { }
+
+				/*
+				 * @brief Dereference operator, returns the element at the current index.
+				 * @return The element at the current index.
+				 * @throw std::runtime_error If checked, and the iterator is not initialized or out of range.
+				*/
+				const T &operator*() const noexcept(!Checked) {
+					this->_checkDereferenceable();
+					return this->_container->_elements[this->_index];
+				}
+		};
+
+		/*
+		 * @brief An iterator over the mapped elements in sidecross order.
+		*/
+		template <bool Checked>
+		class BasicSideCrossIterator: public BasicIndexIterator<BasicSideCrossIterator<Checked>, BasicMappedMagicalContainer, T, Checked>
+		{
+			private:
+				using Base = BasicIndexIterator<BasicSideCrossIterator<Checked>, BasicMappedMagicalContainer, T, Checked>;
+
+				friend Base;
+
+				/*
+				 * @brief Returns the index of the end() iterator.
+				 * @return The amount of elements in the iterated order.
+				*/
+				size_t _limit() const {
+					return this->_container->_count;
+				}
+
+			public:
+				/*
+				 * @brief Construct a new Side Cross Iterator object, uninitialized (points to no container).
+				*/
+				BasicSideCrossIterator() = default;
+
+				/*
+				 * @brief Construct a new Side Cross Iterator object, at the first element of the container.
+				 * @param container The container to iterate over.
+				*/
+				BasicSideCrossIterator(const BasicMappedMagicalContainer &container): Base(&container, 0) { }
+
+				/*
+				 * @brief Dereference operator, returns the element at the current index.
+				 * @return The element at the current index.
+				 * @throw std::runtime_error If checked, and the iterator is not initialized or out of range.
+				*/
+				const T &operator*() const noexcept(!Checked) {
+					this->_checkDereferenceable();
+					return this->_container->_elements[sideCrossToAscending(this->_index, this->_container->_count)];
+				}
+		};
+
+		/*
+		 * @brief An iterator over the mapped prime elements, in ascending order.
+		*/
+		template <bool Checked>
+		class BasicPrimeIterator: public BasicIndexIterator<BasicPrimeIterator<Checked>, BasicMappedMagicalContainer, T, Checked>
+		{
+			private:
+				using Base = BasicIndexIterator<BasicPrimeIterator<Checked>, BasicMappedMagicalContainer, T, Checked>;
+
+				friend Base;
+
+				/*
+				 * @brief Returns the index of the end() iterator.
+				 * @return The amount of elements in the iterated order.
+				*/
+				size_t _limit() const {
+					return this->_container->_prime_count;
+				}
+
+			public:
+				/*
+				 * @brief Construct a new Prime Iterator object, uninitialized (points to no container).
+				*/
+				BasicPrimeIterator() = default;
+
+				/*
+				 * @brief Construct a new Prime Iterator object, at the first prime element of the container.
+				 * @param container The container to iterate over.
+				*/
+				BasicPrimeIterator(const BasicMappedMagicalContainer &container): Base(&container, 0) { }
+
+				/*
+				 * @brief Dereference operator, returns the element at the current index.
+				 * @return The element at the current index.
+				 * @throw std::runtime_error If checked, and the iterator is not initialized or out of range.
+				*/
+				const T &operator*() const noexcept(!Checked) {
+					this->_checkDereferenceable();
+					return this->_container->_elements[this->_container->_prime_order[this->_index]];
+				}
+		};
+
+		/*
+		 * @brief The default iterators, checked unless built as a release build (see CHECKED_ITERATORS).
+		*/
+		using AscendingIterator = BasicAscendingIterator<CHECKED_ITERATORS>;
+		using SideCrossIterator = BasicSideCrossIterator<CHECKED_ITERATORS>;
+		using PrimeIterator = BasicPrimeIterator<CHECKED_ITERATORS>;
+
+		/*
+		 * @brief Iterators that never validate their state, for hot loops over known-valid ranges.
+		*/
+		using UncheckedAscendingIterator = BasicAscendingIterator<false>;
+		using UncheckedSideCrossIterator = BasicSideCrossIterator<false>;
+		using UncheckedPrimeIterator = BasicPrimeIterator<false>;
+	};
+
+	/*
+	 * @brief The mapped container over int, with the default ordering.
+	*/
+	using MappedMagicalContainer = BasicMappedMagicalContainer<int>;
+
+	extern template class BasicMappedMagicalContainer<int16_t>;
+	extern template class BasicMappedMagicalContainer<int>;
+	extern template class BasicMappedMagicalContainer<int, std::greater<int>>;
+	extern template class BasicMappedMagicalContainer<int64_t>;
+	extern template class BasicMappedMagicalContainer<uint64_t>;
+}
@@ -0,0 +1,187 @@
+/*
+ *  Software Systems CPP Course Assignment 5
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include "ParallelBuilder.hpp"
+#include "PrimeSieve.hpp"
+
+using namespace std;
+using namespace ariel;
+
+ParallelBuilder::ParallelBuilder(size_t threads): _threads(threads) {
+	if (_threads == 0)
+		_threads = max(1U, thread::hardware_concurrency());
+}
+
+size_t ParallelBuilder::_partsFor(size_t count) const {
+	return max<size_t>(1, min(_threads, count / MIN_CHUNK));
+}
+
+template <typename Function>
+void ParallelBuilder::_parallelFor(size_t parts, Function function) {
+	vector<thread> workers;
+	// The calling thread runs part 0 itself.
+	workers.reserve(parts - 1);
+
+	auto join = [&workers]() {
+		for (auto &worker : workers)
+			worker.join();
+	};
+
+	// The started workers are joined before an exception leaves, as destroying a joinable thread terminates the process.
+	try
+	{
+		for (size_t part = 1; part < parts; ++part)
+			workers.emplace_back(function, part);
+
+		function(0);
+	}
+
+	catch (...)
+	{
+		join();
+		throw;
+	}
+
+	join();
+}
+
+void ParallelBuilder::_sort(vector<int> &values, size_t parts) {
+	// The bounds of every chunk, chunk i covers [bounds[i], bounds[i + 1]).
+	vector<size_t> bounds(parts + 1);
+
+	for (size_t part = 0; part <= parts; ++part)
+		bounds[part] = values.size() * part / parts;
+
+	auto at = [&values](size_t index) {
+		return values.begin() + static_cast<ptrdiff_t>(index);
+	};
+
+	_parallelFor(parts, [&](size_t part) {
+		sort(at(bounds[part]), at(bounds[part + 1]));
+	});
+
+	// Merge neighbouring sorted runs, doubling the run width every round.
+	for (size_t width = 1; width < parts; width *= 2)
+	{
+		size_t merges = (parts + 2 * width - 1) / (2 * width);
+
+		_parallelFor(merges, [&](size_t merge) {
+			size_t left = merge * 2 * width;
+			size_t middle = min(left + width, parts);
+			size_t right = min(left + 2 * width, parts);
+
+			if (middle < right)
+				inplace_merge(at(bounds[left]), at(bounds[middle]), at(bounds[right]));
+		});
+	}
+}
+
+void ParallelBuilder::_classify(const vector<int> &sorted, size_t parts, vector<int> &elements, vector<MagicalContainer::index_type> &prime_order) {
+	vector<size_t> bounds(parts + 1);
+
+	for (size_t part = 0; part <= parts; ++part)
+		bounds[part] = sorted.size() * part / parts;
+
+	// Per element flags, and per chunk counts of unique and prime elements.
+	constexpr uint8_t UNIQUE = 1, PRIME = 2;
+	vector<uint8_t> flags(sorted.size(), 0);
+	vector<size_t> unique_offsets(parts + 1, 0), prime_offsets(parts + 1, 0);
+
+	_parallelFor(parts, [&](size_t part) {
+		for (size_t index = bounds[part]; index < bounds[part + 1]; ++index)
+		{
+			if (index != 0 && sorted[index] == sorted[index - 1])
+				continue;
+
+			flags[index] = UNIQUE;
+			++unique_offsets[part + 1];
+
+			if (PrimeSieve::isPrime(sorted[index]))
+			{
+				flags[index] |= PRIME;
+				++prime_offsets[part + 1];
+			}
+		}
+	});
+
+	// Prefix sums turn the per chunk counts into every chunk's output offsets.
+	for (size_t part = 0; part < parts; ++part)
+	{
+		unique_offsets[part + 1] += unique_offsets[part];
+		prime_offsets[part + 1] += prime_offsets[part];
+	}
+
+	elements.resize(unique_offsets[parts]);
+	prime_order.resize(prime_offsets[parts]);
+
+	_parallelFor(parts, [&](size_t part) {
+		size_t write = unique_offsets[part], prime_write = prime_offsets[part];
+
+		for (size_t index = bounds[part]; index < bounds[part + 1]; ++index)
+		{
+			if ((flags[index] & PRIME) != 0)
+				prime_order[prime_write++] = static_cast<MagicalContainer::index_type>(write);
+
+			if ((flags[index] & UNIQUE) != 0)
+				elements[write++] = sorted[index];
+		}
+	});
+}
+
+MagicalContainer ParallelBuilder::build(vector<int> values) const {
+	MagicalContainer container;
+	addElements(container, move(values));
+	return container;
+}
+
+void ParallelBuilder::addElements(MagicalContainer &container, vector<int> values) const {
+	if (values.empty())
+		return;
+
+	size_t parts = _partsFor(values.size());
+
+	_sort(values, parts);
+
+	vector<int> elements;
+	vector<MagicalContainer::index_type> prime_order;
+
+	_classify(values, parts, elements, prime_order);
+
+	MagicalContainer::_checkSize(elements.size());
+
+	// An empty container takes the prepared arrays as they are, its filtered views (if any) are built on their next use.
+	if (container.size() == 0)
+	{
+		container._elements.swap(elements);
+		container._elements_prime_order.swap(prime_order);
+		container._prime_order_built.set(true);
+		container._invalidateViews();
+		return;
+	}
+
+	auto prime = prime_order.begin();
+
+	container._merge(elements, [&prime, &prime_order](size_t batch_index) {
+		while (prime != prime_order.end() && *prime < batch_index)
+			++prime;
+
+		return prime != prime_order.end() && *prime == batch_index;
+	});
+}
@@ -0,0 +1,110 @@
+/*
+ *  Software Systems CPP Course Assignment 5
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "MagicalContainer.hpp"
+#include <vector>
+
+namespace ariel
+{
+	/*
+	 * @brief An opt-in builder that bulk loads a MagicalContainer on multiple threads.
+	 * @note The batch is sorted with a parallel sort (sorted chunks, then rounds of parallel merges), then
+	 			deduplicated and classified for primes on all the threads, and finally the ascending storage and
+				the prime order are written in parallel at offsets computed with prefix sums.
+	 * @note Small batches are built on fewer threads, as spawning threads costs more than it saves.
+	*/
+	class ParallelBuilder
+	{
+		private:
+			/*
+			 * @brief The smallest amount of elements worth handing to a thread.
+			*/
+			static constexpr size_t MIN_CHUNK = 1U << 14;
+
+			/*
+			 * @brief The maximum amount of threads to use.
+			*/
+			size_t _threads;
+
+			/*
+			 * @brief Get the amount of chunks to split a batch into.
+			 * @param count The size of the batch.
+			 * @return The amount of chunks, at least 1.
+			*/
+			size_t _partsFor(size_t count) const;
+
+			/*
+			 * @brief Run a function on every part in parallel, one thread per part.
+			 * @param parts The amount of parts.
+			 * @param function A callable that takes the index of a part.
+			 * @note The calling thread runs the first part itself.
+			 * @note If a thread cannot be started or the first part throws, the started threads are joined
+			 			and the exception is rethrown.
+			*/
+			template <typename Function>
+			static void _parallelFor(size_t parts, Function function);
+
+			/*
+			 * @brief Sort a batch in parallel.
+			 * @param values The batch to sort.
+			 * @param parts The amount of chunks to sort in parallel.
+			*/
+			static void _sort(std::vector<int> &values, size_t parts);
+
+			/*
+			 * @brief Deduplicate a sorted batch and classify its primes in parallel.
+			 * @param sorted The sorted batch.
+			 * @param parts The amount of chunks to process in parallel.
+			 * @param elements Filled with the unique elements, in ascending order.
+			 * @param prime_order Filled with the indexes of the prime elements in elements, in ascending order.
+			*/
+			static void _classify(const std::vector<int> &sorted, size_t parts, std::vector<int> &elements, std::vector<MagicalContainer::index_type> &prime_order);
+
+		public:
+			/*
+			 * @brief Construct a new Parallel Builder object.
+			 * @param threads The maximum amount of threads to use, zero means one per hardware thread.
+			*/
+			explicit ParallelBuilder(size_t threads = 0);
+
+			/*
+			 * @brief Return the maximum amount of threads the builder uses.
+			 * @return The maximum amount of threads the builder uses.
+			*/
+			size_t threads() const {
+				return _threads;
+			}
+
+			/*
+			 * @brief Build a new container from a batch of elements.
+			 * @param values The elements, in any order and possibly with duplicates.
+			 * @return A container holding the elements.
+			 * @note Time complexity: O((k log k) / t + k), where t is the amount of threads.
+			*/
+			MagicalContainer build(std::vector<int> values) const;
+
+			/*
+			 * @brief Add a batch of elements to an existing container.
+			 * @param container The container to add to.
+			 * @param values The elements, in any order and possibly with duplicates.
+			 * @note The batch is prepared in parallel, then merged into the container in a single linear pass.
+			*/
+			void addElements(MagicalContainer &container, std::vector<int> values) const;
+	};
+}
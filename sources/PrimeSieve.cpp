@@ -0,0 +1,211 @@
+/*
+ *  Software Systems CPP Course Assignment 5
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "PrimeSieve.hpp"
+
+using namespace std;
+using namespace ariel;
+
+PrimeSieve::PrimeSieve(): _composite(SEGMENT_SIZE / VALUES_PER_WORD, 0), _limit(SEGMENT_SIZE) {
+	// 1 is not a prime, and it is the only odd number the sieve itself won't mark.
+	_markComposite(1);
+
+	for (uint32_t prime = 3; prime * prime < _limit; prime += 2)
+	{
+		if (_isComposite(prime))
+			continue;
+
+		for (uint32_t multiple = prime * prime; multiple < _limit; multiple += 2 * prime)
+			_markComposite(multiple);
+	}
+}
+
+PrimeSieve &PrimeSieve::_instance() {
+	thread_local PrimeSieve sieve;
+	return sieve;
+}
+
+void PrimeSieve::_grow(uint32_t value) {
+	// Round up to a whole segment, so a run of growing values won't sieve again and again.
+	uint32_t new_limit = min(SIEVE_LIMIT, (value / SEGMENT_SIZE + 1) * SEGMENT_SIZE);
+
+	if (new_limit <= _limit)
+		return;
+
+	_composite.resize(new_limit / VALUES_PER_WORD, 0);
+
+	// The base primes are all below sqrt(SIEVE_LIMIT), which the first segment already covers.
+	for (uint32_t prime = 3; prime * prime < new_limit; prime += 2)
+	{
+		if (_isComposite(prime))
+			continue;
+
+		// Start from the first odd multiple of the prime inside the new segment.
+		uint32_t multiple = max(prime * prime, (_limit + prime - 1) / prime * prime);
+
+		if (multiple % 2 == 0)
+			multiple += prime;
+
+		for (; multiple < new_limit; multiple += 2 * prime)
+			_markComposite(multiple);
+	}
+
+	_limit = new_limit;
+}
+
+bool PrimeSieve::_millerRabin(uint32_t num) {
+	uint32_t odd_part = num - 1;
+	uint32_t twos = 0;
+
+	while (odd_part % 2 == 0)
+	{
+		odd_part /= 2;
+		++twos;
+	}
+
+	for (uint64_t witness : {2U, 7U, 61U})
+	{
+		if (witness % num == 0)
+			continue;
+
+		// Modular exponentiation: witness ^ odd_part mod num.
+		uint64_t x = 1, base = witness, exponent = odd_part;
+
+		while (exponent != 0)
+		{
+			if ((exponent & 1U) != 0)
+				x = x * base % num;
+
+			base = base * base % num;
+			exponent >>= 1U;
+		}
+
+		if (x == 1 || x == num - 1)
+			continue;
+
+		bool composite = true;
+
+		for (uint32_t i = 1; i < twos && composite; ++i)
+		{
+			x = x * x % num;
+			composite = (x != num - 1);
+		}
+
+		if (composite)
+			return false;
+	}
+
+	return true;
+}
+
+bool PrimeSieve::_millerRabin(uint64_t num) {
+	__extension__ using uint128 = unsigned __int128;
+
+	// Montgomery form with R = 2^64: inverse is num^-1 mod R (Newton's iteration doubles the correct bits each
+	// step), r1 is R mod num (the Montgomery form of 1) and r2 is R^2 mod num (used to convert into the form).
+	uint64_t inverse = num;
+
+	for (int i = 0; i < 5; ++i)
+		inverse *= 2 - num * inverse;
+
+	uint64_t r1 = (0 - num) % num;
+	uint64_t r2 = static_cast<uint64_t>(static_cast<uint128>(r1) * r1 % num);
+
+	// Montgomery multiplication: a * b * R^-1 mod num, without any division.
+	auto multiply = [num, inverse](uint64_t a, uint64_t b) {
+		uint128 product = static_cast<uint128>(a) * b;
+		uint64_t low = static_cast<uint64_t>(product) * inverse;
+		uint64_t high = static_cast<uint64_t>(product >> 64U);
+		uint64_t correction = static_cast<uint64_t>((static_cast<uint128>(low) * num) >> 64U);
+
+		return (high >= correction) ? high - correction : high - correction + num;
+	};
+
+	uint64_t odd_part = num - 1;
+	uint32_t twos = 0;
+
+	while (odd_part % 2 == 0)
+	{
+		odd_part /= 2;
+		++twos;
+	}
+
+	uint64_t one = r1, minus_one = num - r1;
+
+	for (uint64_t witness : {2ULL, 325ULL, 9375ULL, 28178ULL, 450775ULL, 9780504ULL, 1795265022ULL})
+	{
+		witness %= num;
+
+		if (witness == 0)
+			continue;
+
+		// Modular exponentiation in Montgomery form: witness ^ odd_part mod num.
+		uint64_t x = one, base = multiply(witness, r2);
+
+		for (uint64_t exponent = odd_part; exponent != 0; exponent >>= 1U)
+		{
+			if ((exponent & 1U) != 0)
+				x = multiply(x, base);
+
+			base = multiply(base, base);
+		}
+
+		if (x == one || x == minus_one)
+			continue;
+
+		bool composite = true;
+
+		for (uint32_t i = 1; i < twos && composite; ++i)
+		{
+			x = multiply(x, x);
+			composite = (x != minus_one);
+		}
+
+		if (composite)
+			return false;
+	}
+
+	return true;
+}
+
+bool PrimeSieve::_isPrime32(uint32_t num) {
+	if (num < 2)
+		return false;
+
+	if (num % 2 == 0)
+		return num == 2;
+
+	if (num >= SIEVE_LIMIT)
+		return _millerRabin(num);
+
+	PrimeSieve &sieve = _instance();
+
+	if (num >= sieve._limit)
+		sieve._grow(num);
+
+	return !sieve._isComposite(num);
+}
+
+bool PrimeSieve::_isPrime64(uint64_t num) {
+	if (num <= UINT32_MAX)
+		return _isPrime32(static_cast<uint32_t>(num));
+
+	if (num % 2 == 0)
+		return false;
+
+	return _millerRabin(num);
+}
@@ -0,0 +1,157 @@
+/*
+ *  Software Systems CPP Course Assignment 5
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace ariel
+{
+	/*
+	 * @brief A prime classification engine.
+	 * @note Small values are answered from a segmented Sieve of Eratosthenes bitmap, which grows
+	 			lazily one segment at a time up to SIEVE_LIMIT. Larger values fall back to a deterministic
+				Miller-Rabin test, which is exact for the full 32-bit range. 64-bit values use a deterministic
+				Miller-Rabin test with Montgomery multiplication.
+	 * @note Each thread owns its own sieve, so classification never takes a lock.
+	*/
+	class PrimeSieve
+	{
+		private:
+			/*
+			 * @brief The amount of values covered by a single sieve segment.
+			*/
+			static constexpr uint32_t SEGMENT_SIZE = 1U << 16;
+
+			/*
+			 * @brief The sieve never grows beyond this value, anything at or above it uses Miller-Rabin.
+			 * @note The bitmap only stores odd numbers, so the sieve takes at most SIEVE_LIMIT / 16 bytes.
+			*/
+			static constexpr uint32_t SIEVE_LIMIT = 1U << 22;
+
+			/*
+			 * @brief The amount of bits in a bitmap word.
+			*/
+			static constexpr uint32_t BITS_PER_WORD = 64;
+
+			/*
+			 * @brief The amount of values covered by a bitmap word, as only the odd ones are stored.
+			*/
+			static constexpr uint32_t VALUES_PER_WORD = 2 * BITS_PER_WORD;
+
+			/*
+			 * @brief The sieve bitmap, bit i is set if the odd number 2i + 1 is composite.
+			*/
+			std::vector<uint64_t> _composite;
+
+			/*
+			 * @brief The sieve covers all the values below this limit.
+			*/
+			uint32_t _limit;
+
+			/*
+			 * @brief Construct a new Prime Sieve object, with the first segment already sieved.
+			*/
+			PrimeSieve();
+
+			/*
+			 * @brief Get the calling thread's sieve.
+			 * @return A reference to the calling thread's sieve.
+			*/
+			static PrimeSieve &_instance();
+
+			/*
+			 * @brief Sieve more segments, until the sieve covers the given value.
+			 * @param value The value to cover, must be below SIEVE_LIMIT.
+			 * @note Time complexity: O(k log log k), where k is the amount of newly covered values.
+			*/
+			void _grow(uint32_t value);
+
+			/*
+			 * @brief Check if a given odd value is marked as composite in the bitmap.
+			 * @param value The value to check, must be odd and below _limit.
+			 * @return True if the value is composite, false otherwise.
+			*/
+			bool _isComposite(uint32_t value) const {
+				return ((_composite[value / VALUES_PER_WORD] >> ((value / 2) % BITS_PER_WORD)) & 1U) != 0;
+			}
+
+			/*
+			 * @brief Mark a given odd value as composite in the bitmap.
+			 * @param value The value to mark, must be odd and below _limit.
+			*/
+			void _markComposite(uint32_t value) {
+				_composite[value / VALUES_PER_WORD] |= uint64_t{1} << ((value / 2) % BITS_PER_WORD);
+			}
+
+			/*
+			 * @brief Deterministic Miller-Rabin primality test.
+			 * @param num The number to check, must be odd and bigger than 7.
+			 * @return True if the number is prime, false otherwise.
+			 * @note The witnesses 2, 7 and 61 are enough to make the test exact for every 32-bit number.
+			*/
+			static bool _millerRabin(uint32_t num);
+
+			/*
+			 * @brief Deterministic Miller-Rabin primality test for 64-bit numbers, using Montgomery multiplication.
+			 * @param num The number to check, must be odd and bigger than UINT32_MAX.
+			 * @return True if the number is prime, false otherwise.
+			 * @note The seven witnesses used are known to make the test exact for every 64-bit number.
+			*/
+			static bool _millerRabin(uint64_t num);
+
+			/*
+			 * @brief Checks if a given 32-bit number is prime.
+			 * @param num The number to check.
+			 * @return True if the number is prime, false otherwise.
+			*/
+			static bool _isPrime32(uint32_t num);
+
+			/*
+			 * @brief Checks if a given 64-bit number is prime.
+			 * @param num The number to check.
+			 * @return True if the number is prime, false otherwise.
+			 * @note Numbers that fit in 32 bits take the 32-bit path.
+			*/
+			static bool _isPrime64(uint64_t num);
+
+		public:
+			/*
+			 * @brief Checks if a given number is prime.
+			 * @tparam Integer The integer type of the number, up to 64 bits wide.
+			 * @param num The number to check.
+			 * @return True if the number is prime, false otherwise.
+			 * @note Any number smaller than 2 is not prime.
+			 * @note Time complexity: O(1) amortized below SIEVE_LIMIT, O(log num) above it.
+			*/
+			template <typename Integer>
+			static bool isPrime(Integer num) {
+				static_assert(std::is_integral_v<Integer> && sizeof(Integer) <= sizeof(uint64_t), "PrimeSieve only classifies integers up to 64 bits");
+
+				if (num < 2)
+					return false;
+
+				if constexpr (sizeof(Integer) <= sizeof(uint32_t))
+					return _isPrime32(static_cast<uint32_t>(num));
+
+				else
+					return _isPrime64(static_cast<uint64_t>(num));
+			}
+	};
+}
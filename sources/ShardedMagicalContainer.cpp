@@ -0,0 +1,170 @@
+/*
+ *  Software Systems CPP Course Assignment 5
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <climits>
+#include <thread>
+#include "ShardedMagicalContainer.hpp"
+
+using namespace std;
+using namespace ariel;
+
+ShardedMagicalContainer::ShardedMagicalContainer(size_t shards) {
+	if (shards == 0)
+		shards = max(1U, thread::hardware_concurrency());
+
+	// Split the 2^32 values of the int range into equal slices.
+	constexpr int64_t range = int64_t{1} << 32;
+
+	for (size_t shard = 1; shard < shards; ++shard)
+		_boundaries.push_back(static_cast<int>(INT_MIN + range * static_cast<int64_t>(shard) / static_cast<int64_t>(shards)));
+
+	_boundaries.erase(unique(_boundaries.begin(), _boundaries.end()), _boundaries.end());
+
+	for (size_t shard = 0; shard <= _boundaries.size(); ++shard)
+		_shards.push_back(make_unique<ConcurrentMagicalContainer>());
+}
+
+ShardedMagicalContainer::ShardedMagicalContainer(vector<int> boundaries): _boundaries(move(boundaries)) {
+	if (adjacent_find(_boundaries.begin(), _boundaries.end(), greater_equal<int>()) != _boundaries.end())
+		throw runtime_error("Shard boundaries must be strictly increasing");
+
+	for (size_t shard = 0; shard <= _boundaries.size(); ++shard)
+		_shards.push_back(make_unique<ConcurrentMagicalContainer>());
+}
+
+size_t ShardedMagicalContainer::_shardOf(int value) const {
+	return static_cast<size_t>(upper_bound(_boundaries.begin(), _boundaries.end(), value) - _boundaries.begin());
+}
+
+vector<ConcurrentMagicalContainer::ReadView> ShardedMagicalContainer::_lockAll() const {
+	vector<ConcurrentMagicalContainer::ReadView> views;
+	views.reserve(_shards.size());
+
+	for (const auto &shard : _shards)
+		views.push_back(shard->lockShared());
+
+	return views;
+}
+
+vector<vector<int>> ShardedMagicalContainer::_partition(const vector<int> &batch) const {
+	vector<vector<int>> parts(_shards.size());
+
+	for (int element : batch)
+		parts[_shardOf(element)].push_back(element);
+
+	return parts;
+}
+
+void ShardedMagicalContainer::_addBatch(const vector<int> &batch) {
+	auto parts = _partition(batch);
+
+	for (size_t shard = 0; shard < parts.size(); ++shard)
+	{
+		if (parts[shard].empty())
+			continue;
+
+		_shards[shard]->write([&parts, shard](MagicalContainer &container) {
+			container.addElements(parts[shard].begin(), parts[shard].end());
+		});
+	}
+}
+
+size_t ShardedMagicalContainer::_removeBatch(const vector<int> &batch) {
+	auto parts = _partition(batch);
+	size_t removed = 0;
+
+	for (size_t shard = 0; shard < parts.size(); ++shard)
+	{
+		if (parts[shard].empty())
+			continue;
+
+		removed += _shards[shard]->write([&parts, shard](MagicalContainer &container) {
+			return container.removeElements(parts[shard].begin(), parts[shard].end());
+		});
+	}
+
+	return removed;
+}
+
+vector<size_t> ShardedMagicalContainer::_offsets(const vector<ConcurrentMagicalContainer::ReadView> &views) {
+	vector<size_t> offsets(1, 0);
+	offsets.reserve(views.size() + 1);
+
+	for (const auto &view : views)
+		offsets.push_back(offsets.back() + view.container().size());
+
+	return offsets;
+}
+
+int ShardedMagicalContainer::_nthAscending(const vector<ConcurrentMagicalContainer::ReadView> &views, const vector<size_t> &offsets, size_t rank) {
+	// The last shard that starts at or before the rank is the one that holds it (empty shards start where the next one does).
+	size_t shard = static_cast<size_t>(upper_bound(offsets.begin(), offsets.end() - 1, rank) - offsets.begin()) - 1;
+
+	return views[shard].container().nthAscending(rank - offsets[shard]);
+}
+
+void ShardedMagicalContainer::addElement(int element) {
+	_shards[_shardOf(element)]->addElement(element);
+}
+
+void ShardedMagicalContainer::removeElement(int element) {
+	_shards[_shardOf(element)]->removeElement(element);
+}
+
+size_t ShardedMagicalContainer::removeRange(int low, int high) {
+	if (low >= high)
+		return 0;
+
+	size_t removed = 0;
+
+	for (size_t shard = _shardOf(low); shard <= _shardOf(high - 1); ++shard)
+		removed += _shards[shard]->removeRange(low, high);
+
+	return removed;
+}
+
+bool ShardedMagicalContainer::contains(int element) const {
+	return _shards[_shardOf(element)]->contains(element);
+}
+
+size_t ShardedMagicalContainer::size() const {
+	return _offsets(_lockAll()).back();
+}
+
+int ShardedMagicalContainer::nthAscending(size_t k) const {
+	auto views = _lockAll();
+	auto offsets = _offsets(views);
+
+	if (k >= offsets.back())
+		throw runtime_error("Index out of range");
+
+	return _nthAscending(views, offsets, k);
+}
+
+int ShardedMagicalContainer::nthSideCross(size_t k) const {
+	auto views = _lockAll();
+	auto offsets = _offsets(views);
+	size_t total = offsets.back();
+
+	if (k >= total)
+		throw runtime_error("Index out of range");
+
+	size_t rank = (k % 2 == 0) ? k / 2 : total - 1 - k / 2;
+
+	return _nthAscending(views, offsets, rank);
+}
@@ -0,0 +1,293 @@
+/*
+ *  Software Systems CPP Course Assignment 5
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "ConcurrentMagicalContainer.hpp"
+#include <memory>
+#include <vector>
+#include <initializer_list>
+
+namespace ariel
+{
+	/*
+	 * @brief A MagicalContainer that range-partitions the value space into independent shards.
+	 * @note Each shard is a ConcurrentMagicalContainer with its own lock, so writers touching different
+	 			value ranges never contend. Shard i holds the values in [boundary i-1, boundary i).
+	 * @note Global traversals take the read locks of all the shards, always in shard order, so they see a
+	 			consistent view of the whole container. Writers only ever lock a single shard at a time.
+	 * @note The ascending and prime orders are the concatenation of the shards' orders. The sidecross order
+	 			is computed from global ranks.
+	*/
+	class ShardedMagicalContainer
+	{
+		private:
+			/*
+			 * @brief The shards, in ascending value order.
+			*/
+			std::vector<std::unique_ptr<ConcurrentMagicalContainer>> _shards;
+
+			/*
+			 * @brief The first value of every shard but the first one, sorted.
+			*/
+			std::vector<int> _boundaries;
+
+			/*
+			 * @brief Find the shard a value belongs to.
+			 * @param value The value to look for.
+			 * @return The index of the shard.
+			 * @note Time complexity: O(log s), where s is the amount of shards.
+			*/
+			size_t _shardOf(int value) const;
+
+			/*
+			 * @brief Take the read locks of all the shards, in shard order.
+			 * @return The read views of all the shards, in shard order.
+			*/
+			std::vector<ConcurrentMagicalContainer::ReadView> _lockAll() const;
+
+			/*
+			 * @brief Split a batch of elements by shard.
+			 * @param batch The elements to split.
+			 * @return A batch per shard, in shard order.
+			*/
+			std::vector<std::vector<int>> _partition(const std::vector<int> &batch) const;
+
+			/*
+			 * @brief Add a batch of elements, taking each shard's lock once.
+			 * @param batch The elements to add.
+			*/
+			void _addBatch(const std::vector<int> &batch);
+
+			/*
+			 * @brief Remove a batch of elements, taking each shard's lock once.
+			 * @param batch The elements to remove.
+			 * @return The amount of elements removed.
+			*/
+			size_t _removeBatch(const std::vector<int> &batch);
+
+			/*
+			 * @brief Get the element at a given global ascending rank from a set of locked shards.
+			 * @param views The read views of all the shards.
+			 * @param offsets The global rank of every shard's first element, followed by the total size.
+			 * @param rank The global ascending rank of the element.
+			 * @return The element at the given rank.
+			*/
+			static int _nthAscending(const std::vector<ConcurrentMagicalContainer::ReadView> &views, const std::vector<size_t> &offsets, size_t rank);
+
+			/*
+			 * @brief Compute the global rank of every shard's first element.
+			 * @param views The read views of all the shards.
+			 * @return The global rank of every shard's first element, followed by the total size.
+			*/
+			static std::vector<size_t> _offsets(const std::vector<ConcurrentMagicalContainer::ReadView> &views);
+
+		public:
+			/*
+			 * @brief Construct a new Sharded Magical Container object, splitting the int range evenly.
+			 * @param shards The amount of shards, zero means one per hardware thread.
+			*/
+			explicit ShardedMagicalContainer(size_t shards = 0);
+
+			/*
+			 * @brief Construct a new Sharded Magical Container object, with explicit shard boundaries.
+			 * @param boundaries The first value of every shard but the first one.
+			 * @throw std::runtime_error If the boundaries are not strictly increasing.
+			 * @note Use this when the values are not evenly spread over the int range.
+			*/
+			explicit ShardedMagicalContainer(std::vector<int> boundaries);
+
+			/*
+			 * @brief Return the amount of shards.
+			 * @return The amount of shards.
+			*/
+			size_t shardCount() const {
+				return _shards.size();
+			}
+
+			/*
+			 * @brief Add an element to the container, locking only its shard.
+			 * @param element The element to add.
+			*/
+			void addElement(int element);
+
+			/*
+			 * @brief Add a range of elements to the container, locking each shard once.
+			 * @param first An iterator to the first element to add.
+			 * @param last An iterator past the last element to add.
+			*/
+			template <typename InputIt>
+			void addElements(InputIt first, InputIt last) {
+				_addBatch(std::vector<int>(first, last));
+			}
+
+			/*
+			 * @brief Add a list of elements to the container, locking each shard once.
+			 * @param elements The elements to add.
+			*/
+			void addElements(std::initializer_list<int> elements) {
+				addElements(elements.begin(), elements.end());
+			}
+
+			/*
+			 * @brief Remove an element from the container, locking only its shard.
+			 * @param element The element to remove.
+			 * @throw std::runtime_error If the element does not exist in the container.
+			*/
+			void removeElement(int element);
+
+			/*
+			 * @brief Remove a range of elements from the container, locking each shard once.
+			 * @param first An iterator to the first element to remove.
+			 * @param last An iterator past the last element to remove.
+			 * @return The amount of elements removed.
+			*/
+			template <typename InputIt>
+			size_t removeElements(InputIt first, InputIt last) {
+				return _removeBatch(std::vector<int>(first, last));
+			}
+
+			/*
+			 * @brief Remove a list of elements from the container, locking each shard once.
+			 * @param elements The elements to remove.
+			 * @return The amount of elements removed.
+			*/
+			size_t removeElements(std::initializer_list<int> elements) {
+				return removeElements(elements.begin(), elements.end());
+			}
+
+			/*
+			 * @brief Remove all the elements in the value range [low, high), locking only the shards it overlaps.
+			 * @param low The smallest value to remove.
+			 * @param high The value after the biggest value to remove.
+			 * @return The amount of elements removed.
+			*/
+			size_t removeRange(int low, int high);
+
+			/*
+			 * @brief Check if an element exists in the container, locking only its shard.
+			 * @param element The element to look for.
+			 * @return True if the element exists in the container, false otherwise.
+			*/
+			bool contains(int element) const;
+
+			/*
+			 * @brief Return the size of the container.
+			 * @return The size of the container, as seen with all the shards locked.
+			*/
+			size_t size() const;
+
+			/*
+			 * @brief Get the k-th element in ascending order.
+			 * @param k The zero-based position of the element.
+			 * @return The k-th element in ascending order.
+			 * @throw std::runtime_error If k is not less than the size of the container.
+			 * @note Time complexity: O(s), where s is the amount of shards.
+			*/
+			int nthAscending(size_t k) const;
+
+			/*
+			 * @brief Get the k-th element in sidecross order.
+			 * @param k The zero-based position of the element.
+			 * @return The k-th element in sidecross order.
+			 * @throw std::runtime_error If k is not less than the size of the container.
+			 * @note Time complexity: O(s), where s is the amount of shards.
+			*/
+			int nthSideCross(size_t k) const;
+
+			/*
+			 * @brief Visit every element in ascending order.
+			 * @param visitor A callable that takes an element.
+			 * @note All the shards are read locked for the whole traversal.
+			*/
+			template <typename Visitor>
+			void forEachAscending(Visitor &&visitor) const {
+				auto views = _lockAll();
+
+				for (const auto &view : views)
+				{
+					MagicalContainer::AscendingIterator it(view.container());
+
+					for (auto current = it.begin(); current != it.end(); ++current)
+						visitor(*current);
+				}
+			}
+
+			/*
+			 * @brief Visit every prime element in ascending order.
+			 * @param visitor A callable that takes an element.
+			 * @note All the shards are read locked for the whole traversal.
+			*/
+			template <typename Visitor>
+			void forEachPrime(Visitor &&visitor) const {
+				auto views = _lockAll();
+
+				for (const auto &view : views)
+				{
+					MagicalContainer::PrimeIterator it(view.container());
+
+					for (auto current = it.begin(); current != it.end(); ++current)
+						visitor(*current);
+				}
+			}
+
+			/*
+			 * @brief Visit every element in sidecross order.
+			 * @param visitor A callable that takes an element.
+			 * @note All the shards are read locked for the whole traversal.
+			 * @note The front and back cursors each walk the shards once, so the traversal is O(n + s).
+			*/
+			template <typename Visitor>
+			void forEachSideCross(Visitor &&visitor) const {
+				auto views = _lockAll();
+
+				size_t total = 0;
+
+				for (const auto &view : views)
+					total += view.container().size();
+
+				if (total == 0)
+					return;
+
+				// The front cursor walks forward from the first shard, the back cursor walks backward from the last one.
+				size_t front_shard = 0, front_index = 0;
+				size_t back_shard = views.size() - 1, back_index = views.back().container().size();
+
+				for (size_t visited = 0; visited < total; ++visited)
+				{
+					if (visited % 2 == 0)
+					{
+						while (front_index == views[front_shard].container().size())
+						{
+							++front_shard;
+							front_index = 0;
+						}
+
+						visitor(views[front_shard].container().nthAscending(front_index++));
+					}
+
+					else
+					{
+						while (back_index == 0)
+							back_index = views[--back_shard].container().size();
+
+						visitor(views[back_shard].container().nthAscending(--back_index));
+					}
+				}
+			}
+	};
+}
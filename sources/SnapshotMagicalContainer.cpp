@@ -0,0 +1,41 @@
+/*
+ *  Software Systems CPP Course Assignment 5
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "SnapshotMagicalContainer.hpp"
+
+using namespace std;
+using namespace ariel;
+
+void SnapshotMagicalContainer::addElement(int element) {
+	_publish([element](MagicalContainer &next) { next.addElement(element); });
+}
+
+void SnapshotMagicalContainer::removeElement(int element) {
+	_publish([element](MagicalContainer &next) { next.removeElement(element); });
+}
+
+size_t SnapshotMagicalContainer::removeRange(int low, int high) {
+	return _publish([low, high](MagicalContainer &next) { return next.removeRange(low, high); });
+}
+
+bool SnapshotMagicalContainer::contains(int element) const {
+	return snapshot()->contains(element);
+}
+
+size_t SnapshotMagicalContainer::size() const {
+	return snapshot()->size();
+}
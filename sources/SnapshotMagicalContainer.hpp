@@ -0,0 +1,259 @@
+/*
+ *  Software Systems CPP Course Assignment 5
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "MagicalContainer.hpp"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <initializer_list>
+#include <utility>
+#include <version>
+
+namespace ariel
+{
+	/*
+	 * @brief A versioned MagicalContainer, whose readers work on immutable snapshots.
+	 * @note Writers are serialized on a mutex, apply their change to a private copy of the current version
+	 			and publish it with a single pointer store (read-copy-update). Readers only load that pointer,
+				so they never wait for a writer's copy or mutation and never observe a half-applied change.
+	 * @note Loading and storing the pointer is not lock-free: std::atomic<std::shared_ptr> (libstdc++ 12 and later)
+	 			guards it with an internal spin lock, and toolchains without it (such as libc++ 14) fall back to
+				a mutex. Either way the lock is only held to copy a shared_ptr, so a reader may briefly wait
+				for a concurrent publication or reader, never for a whole write.
+	 * @note Old versions are reclaimed by reference counting: a version is freed once the last snapshot
+	 			holding it is released.
+	 * @note Every write copies the whole container, prefer the bulk operations or update() to batch changes.
+	*/
+	class SnapshotMagicalContainer
+	{
+		public:
+			/*
+			 * @brief An immutable version of the container.
+			 * @note Iterators created over a snapshot stay valid and consistent for as long as the snapshot is held.
+			*/
+			using Snapshot = std::shared_ptr<const MagicalContainer>;
+
+		private:
+#if defined(__cpp_lib_atomic_shared_ptr)
+			/*
+			 * @brief The currently published version.
+			*/
+			std::atomic<Snapshot> _current;
+
+			/*
+			 * @brief Get the currently published version.
+			 * @return The published snapshot.
+			*/
+			Snapshot _load() const {
+				return _current.load();
+			}
+
+			/*
+			 * @brief Publish a new version.
+			 * @param next The version to publish.
+			*/
+			void _store(Snapshot next) {
+				_current.store(std::move(next));
+			}
+#else
+			/*
+			 * @brief The currently published version, guarded by _current_lock.
+			*/
+			Snapshot _current;
+
+			/*
+			 * @brief Guards _current, only for as long as it takes to copy or replace the pointer.
+			*/
+			mutable std::mutex _current_lock;
+
+			/*
+			 * @brief Get the currently published version.
+			 * @return The published snapshot.
+			*/
+			Snapshot _load() const {
+				std::lock_guard<std::mutex> lock(_current_lock);
+				return _current;
+			}
+
+			/*
+			 * @brief Publish a new version.
+			 * @param next The version to publish.
+			 * @note The old version is released outside the lock, as it may be the last reference to it.
+			*/
+			void _store(Snapshot next) {
+				{
+					std::lock_guard<std::mutex> lock(_current_lock);
+					_current.swap(next);
+				}
+			}
+#endif
+
+			/*
+			 * @brief Serializes the writers.
+			*/
+			std::mutex _writer;
+
+			/*
+			 * @brief Apply a change to a copy of the current version, and publish it.
+			 * @param mutation A callable that takes a MagicalContainer reference and modifies it.
+			 * @return Whatever the mutation returns.
+			 * @note If the mutation throws, nothing is published.
+			 * @note The new version's views are built before it is published, as readers share it without a lock.
+			*/
+			template <typename Mutation>
+			decltype(auto) _publish(Mutation &&mutation) {
+				std::lock_guard<std::mutex> lock(_writer);
+				auto next = std::make_shared<MagicalContainer>(*_load());
+
+				if constexpr (std::is_void_v<decltype(mutation(*next))>)
+				{
+					std::forward<Mutation>(mutation)(*next);
+					next->materializeViews();
+					_store(std::move(next));
+				}
+
+				else
+				{
+					decltype(auto) result = std::forward<Mutation>(mutation)(*next);
+					next->materializeViews();
+					_store(std::move(next));
+					return result;
+				}
+			}
+
+		public:
+			/*
+			 * @brief Construct a new Snapshot Magical Container object.
+			 * @note The container is empty by default.
+			*/
+			SnapshotMagicalContainer() {
+				auto initial = std::make_shared<MagicalContainer>();
+				initial->materializeViews();
+				_store(std::move(initial));
+			}
+
+			/*
+			 * @brief Destroy the Snapshot Magical Container object.
+			 * @note Snapshots taken before the destruction stay valid.
+			*/
+			~SnapshotMagicalContainer() = default;
+
+			/*
+			 * @brief The container is neither copyable nor movable, as it owns its writer lock.
+			*/
+			SnapshotMagicalContainer(const SnapshotMagicalContainer &other) = delete;
+			SnapshotMagicalContainer(SnapshotMagicalContainer &&other) = delete;
+			SnapshotMagicalContainer &operator=(const SnapshotMagicalContainer &other) = delete;
+			SnapshotMagicalContainer &operator=(SnapshotMagicalContainer &&other) = delete;
+
+			/*
+			 * @brief Get the currently published version.
+			 * @return An immutable snapshot of the container.
+			 * @note Never waits for a write in progress, only for the pointer copy of a concurrent load or publication.
+			*/
+			Snapshot snapshot() const {
+				return _load();
+			}
+
+			/*
+			 * @brief Add an element to the container, publishing a new version.
+			 * @param element The element to add.
+			*/
+			void addElement(int element);
+
+			/*
+			 * @brief Add a range of elements to the container, publishing a single new version.
+			 * @param first An iterator to the first element to add.
+			 * @param last An iterator past the last element to add.
+			*/
+			template <typename InputIt>
+			void addElements(InputIt first, InputIt last) {
+				std::vector<int> batch(first, last);
+				_publish([&batch](MagicalContainer &next) { next.addElements(batch.begin(), batch.end()); });
+			}
+
+			/*
+			 * @brief Add a list of elements to the container, publishing a single new version.
+			 * @param elements The elements to add.
+			*/
+			void addElements(std::initializer_list<int> elements) {
+				addElements(elements.begin(), elements.end());
+			}
+
+			/*
+			 * @brief Remove an element from the container, publishing a new version.
+			 * @param element The element to remove.
+			 * @throw std::runtime_error If the element does not exist in the container, in which case nothing is published.
+			*/
+			void removeElement(int element);
+
+			/*
+			 * @brief Remove a range of elements from the container, publishing a single new version.
+			 * @param first An iterator to the first element to remove.
+			 * @param last An iterator past the last element to remove.
+			 * @return The amount of elements removed.
+			*/
+			template <typename InputIt>
+			size_t removeElements(InputIt first, InputIt last) {
+				std::vector<int> batch(first, last);
+				return _publish([&batch](MagicalContainer &next) { return next.removeElements(batch.begin(), batch.end()); });
+			}
+
+			/*
+			 * @brief Remove a list of elements from the container, publishing a single new version.
+			 * @param elements The elements to remove.
+			 * @return The amount of elements removed.
+			*/
+			size_t removeElements(std::initializer_list<int> elements) {
+				return removeElements(elements.begin(), elements.end());
+			}
+
+			/*
+			 * @brief Remove all the elements in the value range [low, high), publishing a new version.
+			 * @param low The smallest value to remove.
+			 * @param high The value after the biggest value to remove.
+			 * @return The amount of elements removed.
+			*/
+			size_t removeRange(int low, int high);
+
+			/*
+			 * @brief Apply several changes at once, publishing a single new version.
+			 * @param mutation A callable that takes a MagicalContainer reference and modifies it.
+			 * @return Whatever the mutation returns.
+			 * @note If the mutation throws, nothing is published.
+			*/
+			template <typename Mutation>
+			decltype(auto) update(Mutation &&mutation) {
+				return _publish(std::forward<Mutation>(mutation));
+			}
+
+			/*
+			 * @brief Check if an element exists in the current version.
+			 * @param element The element to look for.
+			 * @return True if the element exists in the current version, false otherwise.
+			*/
+			bool contains(int element) const;
+
+			/*
+			 * @brief Return the size of the current version.
+			 * @return The size of the current version.
+			*/
+			size_t size() const;
+	};
+}
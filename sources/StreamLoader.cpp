@@ -0,0 +1,150 @@
+/*
+ *  Software Systems CPP Course Assignment 5
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "StreamLoader.hpp"
+#include <charconv>
+#include <cstring>
+#include <system_error>
+
+using namespace std;
+using namespace ariel;
+
+namespace
+{
+	/*
+	 * @brief Checks if a character separates values in text input.
+	 * @param character The character to check.
+	 * @return True if the character is whitespace.
+	*/
+	bool isDelimiter(char character) {
+		return character == ' ' || character == '\n' || character == '\r' || character == '\t' || character == '\v' || character == '\f';
+	}
+}
+
+template <typename T>
+size_t BasicStreamLoader<T>::_readText(istream &input, const function<void(const vector<T> &)> &flush) const {
+	vector<char> block(BLOCK_SIZE);
+	vector<T> chunk;
+	size_t carried = 0, total = 0;
+
+	chunk.reserve(_chunk_size);
+
+	while (true)
+	{
+		input.read(block.data() + carried, static_cast<streamsize>(block.size() - carried));
+
+		size_t available = carried + static_cast<size_t>(input.gcount());
+		bool last = !input;
+		const char *cursor = block.data(), *end = block.data() + available;
+
+		while (true)
+		{
+			while (cursor != end && isDelimiter(*cursor))
+				++cursor;
+
+			// A token that runs into the end of the block may continue in the next one.
+			const char *token_end = cursor;
+
+			while (token_end != end && !isDelimiter(*token_end))
+				++token_end;
+
+			if (cursor == end || (token_end == end && !last))
+				break;
+
+			T value {};
+			auto [parsed_end, error] = from_chars(cursor, token_end, value);
+
+			if (error == errc::result_out_of_range)
+				throw runtime_error("Integer out of range in input");
+
+			if (error != errc() || parsed_end != token_end)
+				throw runtime_error("Invalid integer in input");
+
+			chunk.push_back(value);
+			cursor = token_end;
+			++total;
+
+			if (chunk.size() == _chunk_size)
+			{
+				flush(chunk);
+				chunk.clear();
+			}
+		}
+
+		if (last)
+			break;
+
+		// Move the partial token to the start of the block, and fill the rest on the next read.
+		carried = static_cast<size_t>(end - cursor);
+
+		if (carried == block.size())
+			throw runtime_error("Invalid integer in input");
+
+		memmove(block.data(), cursor, carried);
+	}
+
+	if (input.bad())
+		throw runtime_error("Cannot read input");
+
+	if (!chunk.empty())
+		flush(chunk);
+
+	return total;
+}
+
+template <typename T>
+size_t BasicStreamLoader<T>::_readBinary(istream &input, const function<void(const vector<T> &)> &flush) const {
+	vector<T> chunk(_chunk_size);
+	size_t total = 0;
+
+	while (input)
+	{
+		input.read(reinterpret_cast<char *>(chunk.data()), static_cast<streamsize>(chunk.size() * sizeof(T)));
+
+		size_t bytes = static_cast<size_t>(input.gcount());
+
+		if (bytes % sizeof(T) != 0)
+			throw runtime_error("Truncated binary input");
+
+		if (bytes == 0)
+			break;
+
+		size_t values = bytes / sizeof(T);
+
+		// The last chunk is usually partial, hand over only the values that were read.
+		if (values == chunk.size())
+			flush(chunk);
+
+		else
+			flush(vector<T>(chunk.begin(), chunk.begin() + static_cast<ptrdiff_t>(values)));
+
+		total += values;
+	}
+
+	if (input.bad())
+		throw runtime_error("Cannot read input");
+
+	return total;
+}
+
+namespace ariel
+{
+	template class BasicStreamLoader<int16_t>;
+	template class BasicStreamLoader<int>;
+	template class BasicStreamLoader<int64_t>;
+	template class BasicStreamLoader<uint64_t>;
+}
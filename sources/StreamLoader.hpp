@@ -0,0 +1,178 @@
+/*
+ *  Software Systems CPP Course Assignment 5
+ *  Copyright (C) 2023  Roy Simanovich
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <istream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ariel
+{
+	/*
+	 * @brief Streams integers from text or binary input into a container, in bounded memory.
+	 * @tparam T The element type of the target container.
+	 * @note Input is read in fixed-size blocks and parsed with std::from_chars (no locale, no iostream formatting).
+	 			The values are accumulated into a chunk, which is handed to the container's bulk addElements
+				whenever it fills up, so the loader itself only holds one block and one chunk.
+	 * @note Each addElements call merges the chunk into a new copy of the container's storage and orders,
+	 			freeing the old ones afterwards. The peak memory is therefore about twice the container,
+				plus a block and two chunks (addElements sorts its own copy of the chunk). The input as a whole
+				is never held in memory.
+	 * @note Works with any container that has addElements(first, last): MagicalContainer, and the concurrent,
+	 			snapshot and sharded wrappers.
+	 * @note The parsing is explicitly instantiated for int16_t, int, int64_t and uint64_t, see StreamLoader.cpp.
+	*/
+	template <typename T = int>
+	class BasicStreamLoader
+	{
+		public:
+			/*
+			 * @brief The default amount of values per chunk.
+			*/
+			static constexpr size_t DEFAULT_CHUNK_SIZE = 1U << 20;
+
+			/*
+			 * @brief The size of a read block in bytes.
+			*/
+			static constexpr size_t BLOCK_SIZE = 1U << 16;
+
+		private:
+			/*
+			 * @brief The amount of values per chunk.
+			*/
+			size_t _chunk_size;
+
+			/*
+			 * @brief Parse whitespace-delimited integers from a stream, handing them over chunk by chunk.
+			 * @param input The stream to read, to its end.
+			 * @param flush Called with every full chunk, and with the last partial one.
+			 * @return The amount of values read.
+			 * @throw std::runtime_error If the input holds anything but integers and whitespace, or an integer out of T's range.
+			*/
+			size_t _readText(std::istream &input, const std::function<void(const std::vector<T> &)> &flush) const;
+
+			/*
+			 * @brief Read native-endian T values from a stream, handing them over chunk by chunk.
+			 * @param input The stream to read, to its end.
+			 * @param flush Called with every full chunk, and with the last partial one.
+			 * @return The amount of values read.
+			 * @throw std::runtime_error If the input ends in the middle of a value.
+			*/
+			size_t _readBinary(std::istream &input, const std::function<void(const std::vector<T> &)> &flush) const;
+
+			/*
+			 * @brief Open a file for reading.
+			 * @param path The path of the file.
+			 * @return The opened file.
+			 * @throw std::runtime_error If the file cannot be opened.
+			*/
+			static std::ifstream _open(const std::string &path) {
+				std::ifstream file(path, std::ios::binary);
+
+				if (!file)
+					throw std::runtime_error("Cannot open file for reading");
+
+				return file;
+			}
+
+		public:
+			/*
+			 * @brief Construct a new Stream Loader object.
+			 * @param chunk_size The amount of values to insert per batch. Bigger chunks mean fewer merge passes
+			 			over the container, smaller chunks mean less memory.
+			 * @throw std::runtime_error If chunk_size is zero.
+			*/
+			explicit BasicStreamLoader(size_t chunk_size = DEFAULT_CHUNK_SIZE): _chunk_size(chunk_size) {
+				if (chunk_size == 0)
+					throw std::runtime_error("Chunk size must be positive");
+			}
+
+			/*
+			 * @brief Return the amount of values per chunk.
+			 * @return The amount of values per chunk.
+			*/
+			size_t chunkSize() const {
+				return _chunk_size;
+			}
+
+			/*
+			 * @brief Load whitespace-delimited (e.g. newline-delimited) integers from a stream, such as a pipe.
+			 * @param container The container to add the values to.
+			 * @param input The stream to read, to its end.
+			 * @return The amount of values read, including duplicates.
+			 * @throw std::runtime_error If the input is malformed. The chunks inserted before the error stay in the container.
+			*/
+			template <typename Container>
+			size_t loadText(Container &container, std::istream &input) const {
+				return _readText(input, [&container](const std::vector<T> &chunk) { container.addElements(chunk.begin(), chunk.end()); });
+			}
+
+			/*
+			 * @brief Load whitespace-delimited integers from a file.
+			 * @param container The container to add the values to.
+			 * @param path The path of the file.
+			 * @return The amount of values read, including duplicates.
+			 * @throw std::runtime_error If the file cannot be opened or is malformed.
+			*/
+			template <typename Container>
+			size_t loadTextFile(Container &container, const std::string &path) const {
+				std::ifstream file = _open(path);
+				return loadText(container, file);
+			}
+
+			/*
+			 * @brief Load raw native-endian T values from a stream.
+			 * @param container The container to add the values to.
+			 * @param input The stream to read, to its end.
+			 * @return The amount of values read, including duplicates.
+			 * @throw std::runtime_error If the input ends in the middle of a value.
+			*/
+			template <typename Container>
+			size_t loadBinary(Container &container, std::istream &input) const {
+				return _readBinary(input, [&container](const std::vector<T> &chunk) { container.addElements(chunk.begin(), chunk.end()); });
+			}
+
+			/*
+			 * @brief Load raw native-endian T values from a file.
+			 * @param container The container to add the values to.
+			 * @param path The path of the file.
+			 * @return The amount of values read, including duplicates.
+			 * @throw std::runtime_error If the file cannot be opened, or ends in the middle of a value.
+			*/
+			template <typename Container>
+			size_t loadBinaryFile(Container &container, const std::string &path) const {
+				std::ifstream file = _open(path);
+				return loadBinary(container, file);
+			}
+	};
+
+	/*
+	 * @brief The stream loader for int containers.
+	*/
+	using StreamLoader = BasicStreamLoader<int>;
+
+	extern template class BasicStreamLoader<int16_t>;
+	extern template class BasicStreamLoader<int>;
+	extern template class BasicStreamLoader<int64_t>;
+	extern template class BasicStreamLoader<uint64_t>;
+}